@@ -0,0 +1,59 @@
+#ifndef ARBOL_CONCURRENTE_H
+#define ARBOL_CONCURRENTE_H
+
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// Nodo con su propio cerrojo lector/escritor: protege 'hijos' (el nombre es inmutable)
+struct NodoConcurrente {
+    std::string nombre;
+    std::vector<NodoConcurrente*> hijos;
+    mutable std::shared_mutex cerrojo;
+
+    explicit NodoConcurrente(const std::string& nombreNodo);
+
+    ~NodoConcurrente();
+};
+
+// Fragmentos de la raíz: cada hijo directo de la raíz vive en uno, elegido por hash del nombre
+const size_t NUM_FRAGMENTOS_RAIZ = 64;
+
+// Un fragmento por línea de caché, para que sus cerrojos no compartan línea
+struct alignas(64) FragmentoRaiz {
+    NodoConcurrente nodo;
+
+    FragmentoRaiz() : nodo("raiz") {}
+};
+
+// Variante multi-escritor de ArbolSistemaArchivos con bloqueo mano sobre mano (lock coupling).
+// Cada operación baja tomando el cerrojo del hijo antes de soltar el del padre, en modo
+// compartido salvo en el directorio que modifica. La raíz no tiene un cerrojo único: sus hijos
+// se reparten en NUM_FRAGMENTOS_RAIZ fragmentos, cada uno con su cerrojo, así que operaciones en
+// subárboles de primer nivel distintos no tocan ningún cerrojo común (salvo que sus nombres caigan
+// en el mismo fragmento, y aun así solo en modo compartido, si no crean ni borran en la raíz).
+// Más abajo, escritores en subárboles distintos solo comparten cerrojos de lectura.
+class ArbolConcurrente {
+private:
+    std::unique_ptr<FragmentoRaiz[]> fragmentos;
+    NodoConcurrente* fragmentoDe(const std::string& nombre) const;
+    static NodoConcurrente* buscarHijo(const NodoConcurrente* nodo, const std::string& nombre);
+    static void insertarHijoOrdenado(NodoConcurrente* padre, NodoConcurrente* hijo);
+    static void liberarSubarbol(NodoConcurrente* nodo);
+    static int obtenerNumeroNodos(const NodoConcurrente* nodo);
+
+public:
+    ArbolConcurrente();
+    ~ArbolConcurrente();
+    ArbolConcurrente(const ArbolConcurrente&) = delete;
+    ArbolConcurrente& operator=(const ArbolConcurrente&) = delete;
+    void insertarRuta(const std::string& ruta);
+    int buscar(const std::string& ruta) const;
+    int insertar(const std::string& ruta);
+    bool eliminar(const std::string& ruta);
+    int obtenerNumeroNodos() const;
+};
+
+#endif // ARBOL_CONCURRENTE_H
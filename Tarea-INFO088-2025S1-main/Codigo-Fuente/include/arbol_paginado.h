@@ -0,0 +1,109 @@
+#ifndef ARBOL_PAGINADO_H
+#define ARBOL_PAGINADO_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Marco del pool: una página del archivo copiada en memoria
+struct MarcoPagina {
+    std::uint32_t pagina;  // Página cargada (0 = marco libre; la página 0 es la cabecera del archivo)
+    int fijaciones;        // Usuarios activos: un marco fijado no puede desalojarse
+    bool sucia;            // Hay que escribirla antes de desalojarla
+    bool referenciada;     // Bit de referencia del algoritmo del reloj
+    unsigned char* datos;
+};
+
+// Pool de páginas acotado: desalojo por reloj (CLOCK) y escritura diferida de páginas sucias.
+// Los buffers están alineados a página para poder usar O_DIRECT y saltarse la caché del kernel.
+// Los errores de E/S y el pool agotado se informan por std::cerr y fijar retorna nullptr.
+class PoolPaginas {
+private:
+    int fd;
+    unsigned char* memoria;
+    std::vector<MarcoPagina> marcos;
+    std::unordered_map<std::uint32_t, size_t> residentes;
+    size_t manecilla;
+    long long lecturas;
+    long long escrituras;
+    long long aciertos;
+    size_t elegirVictima();
+    bool escribirMarco(MarcoPagina& marco);
+
+public:
+    static const size_t TAMANO_PAGINA = 4096;
+
+    PoolPaginas(int descriptor, size_t capacidad);
+    ~PoolPaginas();
+    PoolPaginas(const PoolPaginas&) = delete;
+    PoolPaginas& operator=(const PoolPaginas&) = delete;
+    unsigned char* fijar(std::uint32_t pagina, bool nueva);
+    void soltar(std::uint32_t pagina, bool sucia);
+    bool vaciar();
+    void descartar();
+    size_t capacidad() const;
+    long long obtenerLecturas() const;
+    long long obtenerEscrituras() const;
+    long long obtenerAciertos() const;
+    void reiniciarContadores();
+};
+
+// Árbol fuera de memoria: cada entrada de directorio se guarda en un árbol B+ paginado en disco
+// con clave (id del padre, nombre) y valor id del hijo. Resolver una ruta cuesta una búsqueda
+// raíz-hoja por componente y solo trae al pool las páginas de ese camino; la memoria usada queda
+// acotada por el pool, no por el número de nodos. Las páginas que quedan vacías al eliminar no
+// se fusionan (se reutiliza su espacio en nuevas inserciones del mismo rango).
+// La página 0 es la cabecera (raíz, contadores y suma de verificación), escrita en cada vaciar():
+// con AperturaPaginado::Abrir se valida y se sigue trabajando sobre un archivo ya guardado. No hay
+// recuperación ante caídas: solo es consistente un archivo cuyo último vaciar() terminó sin errores.
+// Tras un error de E/S el árbol puede quedar a medio modificar, así que deja de aceptar
+// operaciones: buscar retorna -1, insertar 3 y eliminar false.
+enum class AperturaPaginado { Crear, Abrir };
+
+class ArbolPaginado {
+private:
+    int fd;
+    PoolPaginas* pool;
+    std::uint32_t paginaRaiz;
+    std::uint32_t numPaginas;
+    std::uint64_t siguienteId;
+    long long numEntradas;
+    bool directa;
+    bool fallo;
+    bool marcarFallo();
+    bool cargarCabecera(const std::string& rutaArchivo);
+    std::uint32_t nuevaPagina();
+    bool buscarEntrada(const std::string& clave, std::uint64_t& valor);
+    void insertarEntrada(const std::string& clave, std::uint64_t valor);
+    bool insertarEnSubarbol(std::uint32_t pagina, const std::string& clave, std::uint64_t valor,
+                            std::string& separador, std::uint32_t& paginaDerecha);
+    bool eliminarEntrada(const std::string& clave);
+    std::vector<std::pair<std::string, std::uint64_t>> listarHijos(std::uint64_t id, size_t maximo);
+    bool resolver(const std::vector<std::string>& componentes, size_t cuantos, std::uint64_t& id);
+    void eliminarSubarbol(std::uint64_t id);
+    bool guardarCabecera();
+
+public:
+    ArbolPaginado(const std::string& rutaArchivo, size_t paginasEnMemoria, bool entradaSalidaDirecta = true,
+                  AperturaPaginado apertura = AperturaPaginado::Crear);
+    ~ArbolPaginado();
+    ArbolPaginado(const ArbolPaginado&) = delete;
+    ArbolPaginado& operator=(const ArbolPaginado&) = delete;
+    bool abierto() const;
+    bool tieneError() const;
+    bool usaEntradaSalidaDirecta() const;
+    void cargarDatos(const std::string& rutaBase);
+    void insertarRuta(const std::string& ruta);
+    int buscar(const std::string& ruta);
+    int insertar(const std::string& ruta);
+    bool eliminar(const std::string& ruta);
+    long long obtenerNumeroNodos() const;
+    long long obtenerNumeroPaginas() const;
+    void cambiarCapacidad(size_t paginasEnMemoria);
+    bool vaciar();
+    const PoolPaginas& obtenerPool() const;
+    void reiniciarContadores();
+};
+
+#endif // ARBOL_PAGINADO_H
@@ -0,0 +1,62 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <string>
+#include <sys/types.h>
+
+class ArbolSistemaArchivos;
+
+// Configuración del diario de mutaciones
+struct ConfiguracionDiario {
+    std::string rutaDiario;           // Archivo de solo-anexar con las mutaciones
+    std::string rutaPuntoControl;     // Instantánea binaria completa del árbol
+    int tamanoGrupo;                  // Registros por fdatasync (commit en grupo; ver durable())
+    long long registrosPorPuntoControl; // Cada cuántos registros tomar un punto de control (0 = manual)
+    bool sincronizar;                 // false: se escribe pero sin fdatasync (sin durabilidad)
+
+    ConfiguracionDiario() : tamanoGrupo(256), registrosPorPuntoControl(0), sincronizar(true) {}
+};
+
+// Diario de escritura anticipada (WAL) para insertar/eliminar.
+// Cada registro es: operación (1 byte), largo de la ruta (varint), ruta y suma FNV-1a de 32 bits.
+// El árbol registra cada mutación antes de aplicarla. Los registros se acumulan en memoria y se
+// vuelcan con un único write+fdatasync por grupo: con tamanoGrupo > 1 (o sin sincronizar) una
+// mutación ya confirmada al llamador puede perderse en una caída, hasta tamanoGrupo-1 de ellas;
+// solo tamanoGrupo == 1 con sincronizar es durable (ver durable()). Tras un error de escritura
+// o de fdatasync el diario deja de aceptar registros y el árbol rechaza las mutaciones.
+// Al adjuntarlo a un árbol ya cargado hay que tomar un punto de control inicial, porque
+// cargarDatos/insertarRuta no se registran.
+class DiarioMutaciones {
+private:
+    ConfiguracionDiario configuracion;
+    int fd;
+    std::string buffer;
+    int pendientes;
+    long long registrosDesdePuntoControl;
+    long long registrosTotales;
+    long long sincronizaciones;
+    off_t bytesConfirmados;     // Largo del archivo tras el último grupo escrito completo
+    bool errorEscritura;        // Un write o fdatasync falló: no se anexa nada más
+    bool anexar(char operacion, const std::string& ruta);
+
+public:
+    explicit DiarioMutaciones(const ConfiguracionDiario& configuracion);
+    ~DiarioMutaciones();
+    DiarioMutaciones(const DiarioMutaciones&) = delete;
+    DiarioMutaciones& operator=(const DiarioMutaciones&) = delete;
+    bool abierto() const;
+    bool durable() const;
+    bool tieneError() const;
+    bool registrarInsercion(const std::string& ruta);
+    bool registrarEliminacion(const std::string& ruta);
+    bool confirmar();
+    bool puntoControlPendiente() const;
+    bool guardarPuntoControl(const ArbolSistemaArchivos& arbol);
+    long long obtenerRegistrosTotales() const;
+    long long obtenerSincronizaciones() const;
+};
+
+long long reproducirDiario(ArbolSistemaArchivos& arbol, const std::string& rutaDiario);
+long long recuperarArbol(ArbolSistemaArchivos& arbol, const ConfiguracionDiario& configuracion);
+
+#endif // DIARIO_H
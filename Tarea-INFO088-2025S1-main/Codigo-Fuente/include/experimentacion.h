@@ -5,6 +5,8 @@
 #include <vector>
 
 class ArbolSistemaArchivos;
+class ArbolConcurrente;
+struct EstadisticasMemoria;
 
 struct ResultadoExperimento {
     int numDirectorios;        // Número de directorios en la configuración
@@ -15,26 +17,81 @@ struct ResultadoExperimento {
     double tiempoInsercion;    // Tiempo promedio de inserción en nanosegundos
     int alturaArbol;           // Altura del árbol creado
     int numeroNodos;           // Número total de nodos en el árbol
+    long long bytesNodos;      // Memoria en cabeceras de nodo
+    long long bytesNombres;    // Memoria en nombres fuera del SSO
+    long long bytesHijos;      // Memoria usada en arreglos de hijos
+    long long bytesHolgura;    // Capacidad reservada sin usar
+    long long bytesSobrecarga; // Sobrecarga estimada del asignador
+    long long bytesTotal;      // Suma de las categorías anteriores
+    long long bytesReducidos;  // Total tras reducirMemoria()
+    long long nodosCompartido;         // Nodos físicos tras compartirSubarboles()
+    long long bytesCompartido;         // Memoria total del DAG
+    double razonCompresion;            // Nodos lógicos / nodos físicos
+    double razonMemoria;               // Memoria del árbol / memoria del DAG
+    double tiempoBusquedaCompartido;   // Tiempo promedio de búsqueda en el DAG en nanosegundos
 
     ResultadoExperimento() : numDirectorios(0), numArchivos(0), tiempoCreacion(0.0),
                            tiempoBusqueda(0.0), tiempoEliminacion(0.0), tiempoInsercion(0.0),
-                           alturaArbol(0), numeroNodos(0) {}
+                           alturaArbol(0), numeroNodos(0), bytesNodos(0), bytesNombres(0),
+                           bytesHijos(0), bytesHolgura(0), bytesSobrecarga(0), bytesTotal(0),
+                           bytesReducidos(0), nodosCompartido(0), bytesCompartido(0),
+                           razonCompresion(0.0), razonMemoria(0.0), tiempoBusquedaCompartido(0.0) {}
+};
+
+// Barrido empírico de complejidad: pasos geométricos sobre cada eje manteniendo fijos los otros
+struct ConfiguracionBarrido {
+    long long nodosMin, nodosMax;       // Eje de nodos (árbol k-ario completo de grado 'gradoFijo')
+    double factorNodos;
+    int gradoMin, gradoMax;             // Eje de grado (árbol completo de 'nodosFijos' nodos)
+    double factorGrado;
+    int profundidadMin, profundidadMax; // Eje de profundidad (cadenas de 'gradoFijo' hijos por nivel)
+    double factorProfundidad;
+    long long nodosFijos;
+    int gradoFijo;
+    int semillas;                       // Repeticiones de cada punto con distinta semilla
+    int operaciones;                    // Operaciones medidas por punto y semilla
+    std::string archivoCsv;
+
+    ConfiguracionBarrido() : nodosMin(1000), nodosMax(4096000), factorNodos(4.0), gradoMin(2), gradoMax(2048),
+                             factorGrado(4.0), profundidadMin(1), profundidadMax(256), factorProfundidad(4.0),
+                             nodosFijos(100000), gradoFijo(16), semillas(3), operaciones(100000),
+                             archivoCsv("barrido_complejidad.csv") {}
 };
 
 void crearDirectorioPrueba(const std::string& rutaBase, int numDirectorios, int numArchivos);
 double medirTiempoCreacion(const std::string& rutaBase);
-double medirTiempoBusqueda(ArbolSistemaArchivos& arbol, const std::vector<std::string>& rutas);
+double medirTiempoBusqueda(ArbolSistemaArchivos& arbol, const std::vector<std::string>& rutas,
+                           double proporcionFallos = 0.0);
 double medirTiempoEliminacion(ArbolSistemaArchivos& arbol, const std::vector<std::string>& rutas);
 double medirTiempoInsercion(ArbolSistemaArchivos& arbol, const std::vector<std::string>& directorios);
+double medirInsercionConcurrente(ArbolConcurrente& arbol, const std::vector<std::string>& directorios,
+                                 int numHilos, double contencion);
+double medirInsercionCerrojoGlobal(ArbolSistemaArchivos& arbol, const std::vector<std::string>& directorios,
+                                   int numHilos, double contencion);
+void ejecutarExperimentoConcurrente(const std::string& rutaDatos);
+void medirMutacionesConDiario(const std::string& rutaDatos, const std::string& directorioTrabajo);
+std::string rutaSintetica(long long indice, int grado);
+void generarArbolSintetico(ArbolSistemaArchivos& arbol, long long numNodos, int grado);
+void medirDiferencia(const std::vector<long long>& tamanos, const std::vector<double>& tasasCambio);
+std::string rutaEnCadena(long long indice, int grado, int profundidad);
+void ejecutarBarridoComplejidad(const ConfiguracionBarrido& configuracion);
+void medirArbolPaginado(long long numNodos, int grado, const std::string& rutaArchivo);
+void compararFiltroNegativo(const std::string& rutaDatos);
+void medirVisitaParalela(long long numNodos, int grado, unsigned hilosMax);
+void medirManejadoresDirectorio(int numArchivos, int profundidadMaxima);
 ResultadoExperimento ejecutarExperimento(const std::string& rutaBase, int numDirectorios, int numArchivos);
 void ejecutarTodosLosExperimentos(const std::string& rutaBase);
 void guardarResultados(const std::vector<ResultadoExperimento>& resultados, const std::string& nombreArchivo);
 void mostrarResumen(const std::vector<ResultadoExperimento>& resultados);
+void mostrarEstadisticasMemoria(const EstadisticasMemoria& estadisticas);
 void limpiarDirectoriosPrueba(const std::string& rutaBase);
+bool vaciarCachePaginas();
+void compararCargaMetadatos(const std::string& rutaDatos, unsigned profundidadCola);
 
 // Constantes para los experimentos
 extern const int REP;                                     // Número de repeticiones (100,000)
 extern const int NUM_DIRECTORIOS_INSERCION;              
+extern const int NUM_MUTACIONES_DIARIO;
 extern const std::vector<std::string> NOMBRES_ARCHIVOS;  
 
 #endif // EXPERIMENTACION_H
@@ -0,0 +1,34 @@
+#ifndef FILTRO_CUCKOO_H
+#define FILTRO_CUCKOO_H
+
+#include <cstdint>
+#include <vector>
+
+// Filtro cuckoo de pertenencia aproximada sobre hashes de 64 bits: cubetas de 4 huellas de 16 bits
+// y dos cubetas candidatas por clave. Nunca da falsos negativos para lo insertado y, a diferencia
+// de un Bloom, admite eliminar (solo claves que efectivamente se insertaron). La tasa de falsos
+// positivos es del orden de 2·4/2^16 ≈ 0,012% a plena carga.
+class FiltroCuckoo {
+private:
+    static const int HUELLAS_POR_CUBETA = 4;
+    static const int MAX_DESPLAZAMIENTOS = 500;
+    std::vector<std::uint16_t> huellas; // 0 = posición libre
+    std::uint64_t mascara;
+    long long elementos;
+    std::uint64_t estadoAleatorio;
+    static std::uint16_t huella(std::uint64_t hash);
+    std::uint64_t alternativa(std::uint64_t cubeta, std::uint16_t huellaClave) const;
+    bool colocar(std::uint64_t cubeta, std::uint16_t huellaClave);
+    bool contieneEn(std::uint64_t cubeta, std::uint16_t huellaClave) const;
+
+public:
+    explicit FiltroCuckoo(long long capacidad);
+    bool insertar(std::uint64_t hash);
+    bool contiene(std::uint64_t hash) const;
+    bool eliminar(std::uint64_t hash);
+    long long obtenerElementos() const;
+    long long bytesMemoria() const;
+    double ocupacion() const;
+};
+
+#endif // FILTRO_CUCKOO_H
@@ -0,0 +1,49 @@
+#ifndef INDICE_HIJOS_H
+#define INDICE_HIJOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tree.h"
+
+// Directorios con al menos esta cantidad de hijos se buscan con el índice Eytzinger; por debajo
+// el arreglo ordenado completo cabe en pocas líneas de caché y la búsqueda binaria basta
+const size_t UMBRAL_INDICE_HIJOS = 64;
+
+// Clave de orden de 16 bytes de un nombre, comparable como entero de 128 bits
+struct ClaveNombre {
+    std::uint64_t alta;
+    std::uint64_t baja;
+};
+
+// Índice de búsqueda de un directorio grande, aparte del arreglo 'hijos' (que sigue ordenado para
+// enumerar). Guarda en orden Eytzinger (BFS, base 1) una clave de 16 bytes por hijo: los bytes del
+// nombre que siguen al prefijo común de todo el directorio, en big-endian, así que comparar claves
+// equivale a comparar nombres salvo empate. La bajada no tiene saltos impredecibles (k = 2k + menor)
+// y precarga los niveles siguientes, que están contiguos. Solo ante claves iguales (nombres que
+// coinciden en más de 16 bytes tras el prefijo común) se compara el nombre completo.
+//
+// Las inserciones y eliminaciones solo lo invalidan; se reconstruye (O(n)) cuando, después del
+// cambio, el directorio acumula una cantidad de búsquedas proporcional a su tamaño. Mientras tanto
+// buscarHijo usa la búsqueda binaria, así una carga masiva no paga reconstrucciones.
+class IndiceHijos {
+private:
+    std::vector<ClaveNombre> claves;       // Posición 0 sin usar
+    std::vector<std::uint32_t> posiciones; // Índice en 'hijos' de cada clave
+    size_t prefijoComun;
+    size_t busquedasPendientes;            // Búsquedas desde la última invalidación
+    bool valido;
+    void construir(const std::vector<NodoArbol*>& hijos);
+
+public:
+    IndiceHijos();
+    static ClaveNombre clave(const std::string& nombre, size_t desde);
+    void invalidar();
+    bool preparar(const std::vector<NodoArbol*>& hijos);
+    NodoArbol* buscar(const std::vector<NodoArbol*>& hijos, const std::string& nombre) const;
+    long long bytesMemoria() const;
+};
+
+#endif // INDICE_HIJOS_H
@@ -0,0 +1,34 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <string>
+
+// Protocolo de líneas (una petición por línea, respuestas en el mismo orden):
+//   B <ruta>     -> "0" archivo, "1" no existe, "2" directorio  (buscar)
+//   I <ruta>     -> "0" éxito, "1" ya existe, "2" ruta inválida (insertar)
+//   E <ruta>     -> "1" eliminado, "0" no existía               (eliminar)
+//   L <prefijo>  -> "<n>" seguido de n líneas con rutas          (listarPorPrefijo)
+// Cualquier otra línea responde "ERR". Se admite pipelining: el cliente puede enviar
+// muchas peticiones sin esperar y el servidor responde en lote con una sola escritura.
+struct ConfiguracionServidor {
+    std::string rutaDatos;    // Directorio a cargar una sola vez al iniciar
+    std::string rutaSocket;   // Socket Unix a escuchar (vacío = solo entrada/salida estándar)
+    bool usarEntradaEstandar; // Atender también peticiones por stdin/stdout
+
+    ConfiguracionServidor() : usarEntradaEstandar(true) {}
+};
+
+struct ConfiguracionCliente {
+    std::string rutaSocket;
+    int conexiones;             // Conexiones simultáneas
+    int profundidadPipeline;    // Peticiones en vuelo por conexión
+    long long peticiones;       // Total de peticiones a enviar
+    double proporcionEscrituras; // Fracción de I/E (el resto son B)
+
+    ConfiguracionCliente() : conexiones(4), profundidadPipeline(32), peticiones(1000000), proporcionEscrituras(0.0) {}
+};
+
+int ejecutarServidor(const ConfiguracionServidor& configuracion);
+int ejecutarClienteCarga(const ConfiguracionCliente& configuracion);
+
+#endif // SERVIDOR_H
@@ -1,41 +1,172 @@
 #ifndef TREE_H
 #define TREE_H
 
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
+class DiarioMutaciones;
+class FiltroCuckoo;
+class IndiceHijos;
+
+// Tipo de la entrada según el sistema de archivos (Desconocido si no se cargaron metadatos)
+enum class TipoNodo : std::uint8_t { Desconocido, Archivo, Directorio, Enlace, Otro };
+
 struct NodoArbol {
     std::string nombre;
     std::vector<NodoArbol*> hijos;
+    std::uint64_t tamano;      // Tamaño en bytes (solo con cargarDatosConMetadatos)
+    TipoNodo tipo;
+    std::uint32_t referencias;  // Padres que apuntan al nodo (más de uno = compartido e inmutable)
+    mutable std::uint64_t hashSubarbol; // Hash del subárbol en caché (0 = inválido)
+    IndiceHijos* indice;       // Índice Eytzinger de 'hijos' (solo directorios grandes, creado al buscar)
 
     explicit NodoArbol(const std::string& nombre);
 
     ~NodoArbol();
 };
 
+// Estrategia de recorrido para cargarDatosConMetadatos
+enum class ModoCarga {
+    Iterador,   // recursive_directory_iterator + un lstat bloqueante por entrada
+    Sincrono,   // getdents64 + un statx bloqueante por entrada
+    IoUring     // getdents64 + lotes de statx asíncronos vía io_uring
+};
+
+struct EstadisticasCarga {
+    ModoCarga modo;            // Modo efectivamente usado (IoUring cae a Sincrono si no está disponible)
+    long long entradas;        // Entradas insertadas en el árbol
+    long long llamadasSistema; // Syscalls emitidas por el cargador (Iterador: solo los lstat)
+    long long statsPedidos;    // Operaciones statx/lstat realizadas
+    double tiempoMs;           // Tiempo total de carga en milisegundos
+
+    EstadisticasCarga() : modo(ModoCarga::Iterador), entradas(0), llamadasSistema(0),
+                          statsPedidos(0), tiempoMs(0.0) {}
+};
+
+// Huella de memoria del árbol por categoría (estimada para el asignador de glibc)
+struct EstadisticasMemoria {
+    long long nodos;            // Nodos contados
+    long long bytesNodos;       // Cabeceras: sizeof(NodoArbol) por nodo
+    long long bytesNombres;     // Buffers de nombres en el heap (los que no caben en el SSO)
+    long long bytesHijos;       // Parte usada de los arreglos 'hijos'
+    long long bytesHolgura;     // Capacidad reservada y sin usar en 'hijos' y en los nombres
+    long long bytesSobrecarga;  // Cabecera y redondeo del asignador por cada bloque
+    std::vector<long long> histogramaGrado; // Directorios con grado en [2^i, 2^(i+1))
+
+    EstadisticasMemoria() : nodos(0), bytesNodos(0), bytesNombres(0), bytesHijos(0),
+                            bytesHolgura(0), bytesSobrecarga(0) {}
+
+    long long total() const {
+        return bytesNodos + bytesNombres + bytesHijos + bytesHolgura + bytesSobrecarga;
+    }
+};
+
+// Tipos de cambio que emite diferencia()
+enum class TipoCambio { Agregado, Eliminado, CambioTipo };
+
+// Receptor de cambios: ruta relativa del cambio y nodo en el árbol nuevo (nullptr si se eliminó)
+using ReceptorCambios = std::function<void(TipoCambio, const std::string&, const NodoArbol*)>;
+
+// Manejador estable de un directorio, al estilo de un descriptor de openat: ranura en la tabla del
+// árbol más la generación con que se abrió. Eliminar el directorio (o un ancestro), cerrarlo o
+// recargar el árbol avanza la generación de la ranura, así un manejador viejo se detecta como
+// inválido en vez de quedar colgando como un NodoArbol*
+struct ManejadorDirectorio {
+    std::uint32_t ranura;
+    std::uint32_t generacion; // 0 = manejador nulo (abrirDirectorio falló)
+};
+
+// Entrada de la tabla de manejadores: todo lo que una operación relativa necesita para no volver a
+// bajar desde la raíz
+struct RanuraDirectorio {
+    NodoArbol* nodo;                   // nullptr = ranura libre
+    std::vector<NodoArbol*> ancestros; // Camino raíz ... padre, para invalidar hashes y detectar eliminaciones
+    std::string ruta;                  // Ruta completa normalizada, para el diario
+    std::uint64_t estadoHash;          // Estado FNV de la ruta, para el filtro negativo
+    std::uint32_t generacion;
+};
+
+class ArbolSistemaArchivos;
+void diferencia(const ArbolSistemaArchivos& a, const ArbolSistemaArchivos& b, const ReceptorCambios& receptor);
+long long fusionar(ArbolSistemaArchivos& destino, const ArbolSistemaArchivos& base, const ArbolSistemaArchivos& nuevo);
+
 class ArbolSistemaArchivos {
 private:
     NodoArbol* raiz;
-    int obtenerAltura(NodoArbol* nodo) const;
-    int obtenerNumeroNodos(NodoArbol* nodo) const;
+    DiarioMutaciones* diario;   // Opcional: registra cada insertar/eliminar antes de aplicarlo
+    FiltroCuckoo* filtro;       // Opcional: rutas existentes, para que buscar rechace fallos sin bajar
+    bool compartido;            // compartirSubarboles() convirtió el árbol en un DAG
+    std::vector<RanuraDirectorio> ranuras;      // Tabla de manejadores de directorio
+    std::vector<std::uint32_t> ranurasLibres;
+    size_t manejadoresAbiertos;
+    int obtenerAlturaRecursivo(NodoArbol* nodo) const;
+    int obtenerNumeroNodosRecursivo(NodoArbol* nodo) const;
     void obtenerRutasRecursivo(NodoArbol* nodo, const std::string& rutaActual, std::vector<std::string>& rutas) const;
     void obtenerDirectoriosRecursivo(NodoArbol* nodo, const std::string& rutaActual, std::vector<std::string>& directorios) const;
+    static void acumularMemoria(const NodoArbol* nodo, EstadisticasMemoria& estadisticas);
+    void reducirMemoria(NodoArbol* nodo);
+    void listarSubarbol(const NodoArbol* nodo, std::string& ruta, std::vector<std::string>& rutas) const;
+    static std::uint64_t estadoHashRuta(const std::string& ruta);
+    static std::uint64_t extenderEstadoRuta(std::uint64_t estado, const std::string& rutaRelativa);
+    static std::uint64_t finalizarEstadoRuta(std::uint64_t estado);
+    bool registrarSubarbolEnFiltro(const NodoArbol* nodo, std::uint64_t estado, bool agregar);
+    void reconstruirFiltro();
+    static NodoArbol* hijoPropio(NodoArbol* padre, NodoArbol* hijo);
+    int buscarDesde(NodoArbol* inicio, const std::vector<std::string>& componentes);
+    NodoArbol* bajarParaModificar(NodoArbol* inicio, const std::vector<std::string>& componentes);
+    bool eliminarHijo(NodoArbol* padre, const std::string& nombre, std::uint64_t estado);
+    bool registrarEnDiario(bool insercion, const std::string& ruta);
+    void tomarPuntoControlPendiente();
+    RanuraDirectorio* resolverManejador(ManejadorDirectorio manejador);
+    void liberarRanura(std::uint32_t indice);
+    void invalidarManejadoresBajo(const NodoArbol* nodo);
+    void invalidarManejadores();
+    friend void diferencia(const ArbolSistemaArchivos& a, const ArbolSistemaArchivos& b, const ReceptorCambios& receptor);
+    friend long long fusionar(ArbolSistemaArchivos& destino, const ArbolSistemaArchivos& base, const ArbolSistemaArchivos& nuevo);
 
 public:
     ArbolSistemaArchivos();
+    ArbolSistemaArchivos(const ArbolSistemaArchivos& otro);
+    ArbolSistemaArchivos& operator=(const ArbolSistemaArchivos& otro);
     ~ArbolSistemaArchivos();
     void cargarDatos(const std::string& rutaBase);
-    void insertarRuta(const std::string& ruta);
-    std::vector<std::string> dividirRuta(const std::string& ruta);
+    const NodoArbol* obtenerRaiz() const;
+    EstadisticasCarga cargarDatosConMetadatos(const std::string& rutaBase, ModoCarga modo = ModoCarga::IoUring,
+                                              unsigned profundidadCola = 256);
+    NodoArbol* insertarRuta(const std::string& ruta);
+    static std::vector<std::string> dividirRuta(const std::string& ruta);
     NodoArbol* buscarHijo(NodoArbol* nodo, const std::string& nombre);
     void insertarHijoOrdenado(NodoArbol* padre, NodoArbol* hijo);
     int buscar(const std::string& ruta);
     int insertar(const std::string& ruta);
     bool eliminar(const std::string& ruta);
-    int obtenerAltura() const;
-    int obtenerNumeroNodos() const;
+    int obtenerAltura(unsigned hilos = 1) const;
+    int obtenerNumeroNodos(unsigned hilos = 1) const;
     std::vector<std::string> obtenerTodasLasRutas() const;
     std::vector<std::string> obtenerTodosLosDirectorios() const;
+    std::vector<std::string> listarPorPrefijo(const std::string& prefijo) const;
+    EstadisticasMemoria estadisticasMemoria() const;
+    long long reducirMemoria();
+    long long compartirSubarboles();
+    void adjuntarDiario(DiarioMutaciones* diarioMutaciones);
+    void guardarInstantanea(std::ostream& salida) const;
+    bool cargarInstantanea(std::istream& entrada);
+    static NodoArbol* clonarSubarbol(const NodoArbol* nodo);
+    static std::uint64_t hashSubarbol(const NodoArbol* nodo);
+    std::uint64_t hashArbol() const;
+    void activarFiltroNegativo();
+    void desactivarFiltroNegativo();
+    const FiltroCuckoo* obtenerFiltroNegativo() const;
+    static std::uint64_t hashRuta(const std::string& ruta);
+    ManejadorDirectorio abrirDirectorio(const std::string& ruta);
+    void cerrarDirectorio(ManejadorDirectorio manejador);
+    bool manejadorValido(ManejadorDirectorio manejador) const;
+    int buscarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa);
+    int insertarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa);
+    bool eliminarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa);
 };
 
 #endif // TREE_H
@@ -0,0 +1,211 @@
+#ifndef VISITANTE_PARALELO_H
+#define VISITANTE_PARALELO_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tree.h"
+
+// Equipo de hilos ayudantes persistente (se crea al primer uso y crece a pedido). Un recorrido a
+// la vez: si el equipo está ocupado (otro recorrido en curso o una llamada anidada desde la
+// función de mapeo), lanzar() retorna false y quien llama sigue solo.
+class EquipoHilos {
+private:
+    std::vector<std::thread> hilos;
+    std::mutex cerrojo;
+    std::condition_variable hayTrabajo;
+    std::condition_variable terminado;
+    std::function<void(unsigned)> trabajo;
+    unsigned activos;        // Ayudantes que deben correr el trabajo actual
+    unsigned enCurso;        // Ayudantes que aún no terminan el trabajo actual
+    unsigned long long ronda;
+    bool cerrando;
+    std::atomic<bool> ocupado; // Tomado por el recorrido que usa el equipo
+    void bucleAyudante(unsigned indice);
+
+public:
+    EquipoHilos();
+    ~EquipoHilos();
+    EquipoHilos(const EquipoHilos&) = delete;
+    EquipoHilos& operator=(const EquipoHilos&) = delete;
+    static EquipoHilos& global();
+    bool lanzar(unsigned ayudantes, std::function<void(unsigned)> funcion);
+    void esperar();
+};
+
+// Contexto de cada nodo visitado: profundidad y cadena de ancestros (nivel 0 = nodo inicial),
+// sin construir rutas. escribirRuta arma la ruta solo si la función de mapeo la necesita.
+class ContextoVisita {
+private:
+    const NodoArbol* const* camino;
+    int nivel;
+
+public:
+    ContextoVisita(const NodoArbol* const* caminoNodos, int profundidadNodo)
+        : camino(caminoNodos), nivel(profundidadNodo) {}
+
+    int profundidad() const { return nivel; }
+    const NodoArbol* padre() const { return nivel > 0 ? camino[nivel - 1] : nullptr; }
+    const NodoArbol* ancestro(int profundidadAncestro) const { return camino[profundidadAncestro]; }
+
+    // Ruta relativa al nodo inicial (que no forma parte de ella), como en obtenerTodasLasRutas
+    void escribirRuta(std::string& ruta) const {
+        ruta.clear();
+        for (int i = 1; i <= nivel; ++i) {
+            if (i > 1) ruta += '/';
+            ruta += camino[i]->nombre;
+        }
+    }
+};
+
+// Subárbol pendiente en una cola de robo: lleva su cadena de ancestros para armar el contexto
+struct TareaVisita {
+    const NodoArbol* nodo;
+    std::vector<const NodoArbol*> ancestros;
+};
+
+// Nodos que el hilo que llama visita solo antes de despertar ayudantes: con árboles chicos el
+// recorrido termina antes de pagar la coordinación
+const long long UMBRAL_VISITA_PARALELA = 4096;
+
+// Función para recorrer en paralelo el subárbol de 'inicio' con mapeo/reducción.
+// Cada hilo acumula en su propio parcial (partiendo de 'identidad') llamando
+// mapear(parcial, nodo, contexto) por nodo; al final los parciales se combinan con
+// reducir(destino, parcial). El orden de visita no está definido, así que reducir debe ser
+// asociativa y conmutativa. El árbol no debe modificarse durante el recorrido.
+//
+// Reparto por robo de trabajo: cada hilo baja en profundidad con una pila privada (sin cerrojos
+// por nodo) y solo cuando hay hilos sin trabajo publica en su cola el pendiente más alto de la
+// pila (el subárbol más grande). Los ociosos roban del frente de las colas ajenas.
+// hilos = 0 usa std::thread::hardware_concurrency().
+template <typename Acumulador, typename Mapeo, typename Reduccion>
+Acumulador visitarParalelo(const NodoArbol* inicio, const Acumulador& identidad, Mapeo mapear,
+                           Reduccion reducir, unsigned hilos = 0) {
+    if (!inicio) return identidad;
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+
+    struct alignas(64) Parcial {
+        Acumulador valor;
+    };
+    struct alignas(64) ColaRobo {
+        std::mutex cerrojo;
+        std::deque<TareaVisita> tareas;
+    };
+    struct Entrada {
+        const NodoArbol* nodo;
+        int profundidad;
+    };
+
+    std::vector<Parcial> parciales(hilos, Parcial{identidad});
+    std::deque<ColaRobo> colas(hilos);
+    std::atomic<long long> pendientes(1); // Tareas publicadas o en proceso
+    std::atomic<int> hambrientos(0);      // Hilos buscando qué robar
+    bool lanzados = false;
+    long long visitadosSolo = 0;
+
+    std::function<void(unsigned)> trabajar;
+
+    // Procesa una tarea completa con una pila privada; publica trabajo si alguien lo pide
+    auto procesar = [&](unsigned indice, TareaVisita& tarea) {
+        Acumulador& parcial = parciales[indice].valor;
+        std::vector<const NodoArbol*> camino = std::move(tarea.ancestros);
+        std::vector<Entrada> pila;
+        size_t base = 0;
+        pila.push_back({tarea.nodo, static_cast<int>(camino.size())});
+
+        while (pila.size() > base) {
+            Entrada actual = pila.back();
+            pila.pop_back();
+            camino.resize(static_cast<size_t>(actual.profundidad));
+            camino.push_back(actual.nodo);
+            mapear(parcial, *actual.nodo, ContextoVisita(camino.data(), actual.profundidad));
+
+            const std::vector<NodoArbol*>& hijos = actual.nodo->hijos;
+            for (auto it = hijos.rbegin(); it != hijos.rend(); ++it) {
+                pila.push_back({*it, actual.profundidad + 1});
+            }
+
+            // El hilo que llama despierta a los ayudantes solo si el árbol resulta grande
+            if (indice == 0 && !lanzados && hilos > 1 && ++visitadosSolo == UMBRAL_VISITA_PARALELA) {
+                lanzados = EquipoHilos::global().lanzar(hilos - 1, trabajar);
+            }
+
+            // Publicar el pendiente más cercano a la raíz: sus ancestros siguen en 'camino'
+            if (hambrientos.load(std::memory_order_relaxed) > 0 && pila.size() - base >= 2) {
+                ColaRobo& cola = colas[indice];
+                std::lock_guard<std::mutex> guardia(cola.cerrojo);
+                if (cola.tareas.empty()) {
+                    Entrada publicada = pila[base++];
+                    TareaVisita nueva;
+                    nueva.nodo = publicada.nodo;
+                    nueva.ancestros.assign(camino.begin(), camino.begin() + publicada.profundidad);
+                    pendientes.fetch_add(1, std::memory_order_relaxed);
+                    cola.tareas.push_back(std::move(nueva));
+                }
+            }
+        }
+        pendientes.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    // Toma de la propia cola por atrás o roba de las demás por adelante
+    auto obtenerTarea = [&](unsigned indice, TareaVisita& tarea) {
+        for (unsigned k = 0; k < hilos; ++k) {
+            unsigned victima = (indice + k) % hilos;
+            ColaRobo& cola = colas[victima];
+            std::lock_guard<std::mutex> guardia(cola.cerrojo);
+            if (cola.tareas.empty()) continue;
+            if (k == 0) {
+                tarea = std::move(cola.tareas.back());
+                cola.tareas.pop_back();
+            } else {
+                tarea = std::move(cola.tareas.front());
+                cola.tareas.pop_front();
+            }
+            return true;
+        }
+        return false;
+    };
+
+    trabajar = [&](unsigned indice) {
+        TareaVisita tarea;
+        bool hambriento = false;
+        while (pendientes.load(std::memory_order_acquire) > 0) {
+            if (obtenerTarea(indice, tarea)) {
+                if (hambriento) {
+                    hambrientos.fetch_sub(1, std::memory_order_relaxed);
+                    hambriento = false;
+                }
+                procesar(indice, tarea);
+            } else {
+                if (!hambriento) {
+                    hambrientos.fetch_add(1, std::memory_order_relaxed);
+                    hambriento = true;
+                }
+                std::this_thread::yield();
+            }
+        }
+        if (hambriento) hambrientos.fetch_sub(1, std::memory_order_relaxed);
+    };
+
+    TareaVisita primera;
+    primera.nodo = inicio;
+    procesar(0, primera);
+    trabajar(0);
+    if (lanzados) EquipoHilos::global().esperar();
+
+    Acumulador resultado = std::move(parciales[0].valor);
+    for (unsigned i = 1; i < hilos; ++i) {
+        reducir(resultado, parciales[i].valor);
+    }
+    return resultado;
+}
+
+#endif // VISITANTE_PARALELO_H
@@ -0,0 +1,243 @@
+#include "arbol_concurrente.h"
+#include "tree.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+// Cerrojo tomado durante el descenso, recordando si es exclusivo o compartido
+struct CerrojoTomado {
+    NodoConcurrente* nodo;
+    bool exclusivo;
+
+    void liberar() {
+        if (!nodo) return;
+        if (exclusivo) {
+            nodo->cerrojo.unlock();
+        } else {
+            nodo->cerrojo.unlock_shared();
+        }
+        nodo = nullptr;
+    }
+};
+
+} // namespace
+
+// Constructor del nodo
+NodoConcurrente::NodoConcurrente(const std::string& nombreNodo) : nombre(nombreNodo) {}
+
+// Destructor del nodo (sin cerrojos: solo se usa cuando nadie más puede alcanzarlo)
+NodoConcurrente::~NodoConcurrente() {
+    for (auto* hijo : hijos) {
+        delete hijo;
+    }
+}
+
+// Constructor del árbol
+ArbolConcurrente::ArbolConcurrente() : fragmentos(new FragmentoRaiz[NUM_FRAGMENTOS_RAIZ]) {}
+
+// Destructor del árbol (cada fragmento libera sus subárboles)
+ArbolConcurrente::~ArbolConcurrente() {}
+
+// Función para obtener el fragmento de la raíz que guarda al hijo directo 'nombre'
+NodoConcurrente* ArbolConcurrente::fragmentoDe(const std::string& nombre) const {
+    return &fragmentos[std::hash<std::string>{}(nombre) % NUM_FRAGMENTOS_RAIZ].nodo;
+}
+
+// Función para buscar un hijo por nombre (el llamador debe tener el cerrojo del nodo)
+NodoConcurrente* ArbolConcurrente::buscarHijo(const NodoConcurrente* nodo, const std::string& nombre) {
+    auto it = std::lower_bound(nodo->hijos.begin(), nodo->hijos.end(), nombre,
+        [](const NodoConcurrente* a, const std::string& b) {
+            return a->nombre < b;
+        });
+
+    if (it != nodo->hijos.end() && (*it)->nombre == nombre) {
+        return *it;
+    }
+    return nullptr;
+}
+
+// Función para insertar un hijo ordenado (el llamador debe tener el cerrojo exclusivo del padre)
+void ArbolConcurrente::insertarHijoOrdenado(NodoConcurrente* padre, NodoConcurrente* hijo) {
+    auto it = std::lower_bound(padre->hijos.begin(), padre->hijos.end(), hijo,
+        [](const NodoConcurrente* a, const NodoConcurrente* b) {
+            return a->nombre < b->nombre;
+        });
+
+    padre->hijos.insert(it, hijo);
+}
+
+// Función para liberar un subárbol ya desenganchado cuyo cerrojo exclusivo se posee.
+// Toma cada hijo en exclusivo antes de borrarlo para esperar a los lectores que aún
+// estén más abajo; como todos bajan en el mismo orden no puede haber interbloqueo.
+void ArbolConcurrente::liberarSubarbol(NodoConcurrente* nodo) {
+    for (NodoConcurrente* hijo : nodo->hijos) {
+        hijo->cerrojo.lock();
+        liberarSubarbol(hijo);
+        hijo->cerrojo.unlock();
+        delete hijo;
+    }
+    nodo->hijos.clear();
+}
+
+// Función para insertar una ruta creando los directorios intermedios que falten
+void ArbolConcurrente::insertarRuta(const std::string& ruta) {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (componentes.empty()) return; // La raíz siempre existe
+
+    // Se mantiene tomado el padre del nodo actual: mientras tanto nadie puede eliminar
+    // el nodo actual, lo que permite soltar su cerrojo compartido y retomarlo exclusivo
+    NodoConcurrente* fragmento = fragmentoDe(componentes.front());
+    CerrojoTomado padre{nullptr, false};
+    CerrojoTomado actual{fragmento, false};
+    fragmento->cerrojo.lock_shared();
+
+    for (const std::string& componente : componentes) {
+        NodoConcurrente* hijo = buscarHijo(actual.nodo, componente);
+        if (!hijo && !actual.exclusivo) {
+            actual.nodo->cerrojo.unlock_shared();
+            actual.nodo->cerrojo.lock();
+            actual.exclusivo = true;
+            hijo = buscarHijo(actual.nodo, componente); // Otro escritor pudo crearlo entretanto
+        }
+        if (!hijo) {
+            hijo = new NodoConcurrente(componente);
+            insertarHijoOrdenado(actual.nodo, hijo);
+        }
+
+        hijo->cerrojo.lock_shared();
+        padre.liberar();
+        padre = actual;
+        actual = {hijo, false};
+    }
+
+    actual.liberar();
+    padre.liberar();
+}
+
+// Función de búsqueda por ruta (0 archivo, 1 no existe, 2 directorio)
+int ArbolConcurrente::buscar(const std::string& ruta) const {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (componentes.empty()) {
+        // La raíz es un directorio si algún fragmento tiene hijos
+        for (size_t i = 0; i < NUM_FRAGMENTOS_RAIZ; ++i) {
+            std::shared_lock<std::shared_mutex> cerrojo(fragmentos[i].nodo.cerrojo);
+            if (!fragmentos[i].nodo.hijos.empty()) return 2;
+        }
+        return 0;
+    }
+
+    NodoConcurrente* actual = fragmentoDe(componentes.front());
+    actual->cerrojo.lock_shared();
+
+    for (const std::string& componente : componentes) {
+        NodoConcurrente* hijo = buscarHijo(actual, componente);
+        if (!hijo) {
+            actual->cerrojo.unlock_shared();
+            return 1; // No existe
+        }
+        hijo->cerrojo.lock_shared();
+        actual->cerrojo.unlock_shared();
+        actual = hijo;
+    }
+
+    int resultado = actual->hijos.empty() ? 0 : 2;
+    actual->cerrojo.unlock_shared();
+    return resultado;
+}
+
+// Función para insertar un nuevo archivo/directorio (0 éxito, 1 ya existe, 2 ruta inválida)
+int ArbolConcurrente::insertar(const std::string& ruta) {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (componentes.empty()) return 2; // Ruta inválida
+
+    // Bajar en compartido y tomar en exclusivo solo el directorio padre
+    NodoConcurrente* actual = fragmentoDe(componentes.front());
+    componentes.size() == 1 ? actual->cerrojo.lock() : actual->cerrojo.lock_shared();
+
+    for (size_t i = 0; i + 1 < componentes.size(); ++i) {
+        NodoConcurrente* hijo = buscarHijo(actual, componentes[i]);
+        if (!hijo) {
+            actual->cerrojo.unlock_shared();
+            return 2; // No existe la ruta padre
+        }
+
+        bool hijoEsPadre = i + 2 == componentes.size();
+        hijoEsPadre ? hijo->cerrojo.lock() : hijo->cerrojo.lock_shared();
+        actual->cerrojo.unlock_shared();
+        actual = hijo;
+    }
+
+    int resultado = 1; // Ya existe
+    if (!buscarHijo(actual, componentes.back())) {
+        insertarHijoOrdenado(actual, new NodoConcurrente(componentes.back()));
+        resultado = 0;
+    }
+
+    actual->cerrojo.unlock();
+    return resultado;
+}
+
+// Función para eliminar un archivo/directorio junto con su subárbol
+bool ArbolConcurrente::eliminar(const std::string& ruta) {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (componentes.empty()) return false;
+
+    NodoConcurrente* padre = fragmentoDe(componentes.front());
+    componentes.size() == 1 ? padre->cerrojo.lock() : padre->cerrojo.lock_shared();
+
+    for (size_t i = 0; i + 1 < componentes.size(); ++i) {
+        NodoConcurrente* hijo = buscarHijo(padre, componentes[i]);
+        if (!hijo) {
+            padre->cerrojo.unlock_shared();
+            return false; // No existe la ruta padre
+        }
+
+        i + 2 == componentes.size() ? hijo->cerrojo.lock() : hijo->cerrojo.lock_shared();
+        padre->cerrojo.unlock_shared();
+        padre = hijo;
+    }
+
+    auto it = std::lower_bound(padre->hijos.begin(), padre->hijos.end(), componentes.back(),
+        [](const NodoConcurrente* a, const std::string& b) {
+            return a->nombre < b;
+        });
+    if (it == padre->hijos.end() || (*it)->nombre != componentes.back()) {
+        padre->cerrojo.unlock();
+        return false; // No existe el nodo
+    }
+
+    // Esperar a que salgan los lectores del nodo y desengancharlo; desde aquí nadie nuevo
+    // puede alcanzarlo, así que el padre ya puede liberarse
+    NodoConcurrente* nodo = *it;
+    nodo->cerrojo.lock();
+    padre->hijos.erase(it);
+    padre->cerrojo.unlock();
+
+    liberarSubarbol(nodo);
+    nodo->cerrojo.unlock();
+    delete nodo;
+
+    return true;
+}
+
+// Función para obtener el número total de nodos (la raíz cuenta una vez, no una por fragmento)
+int ArbolConcurrente::obtenerNumeroNodos() const {
+    int contador = 1;
+    for (size_t i = 0; i < NUM_FRAGMENTOS_RAIZ; ++i) {
+        contador += obtenerNumeroNodos(&fragmentos[i].nodo) - 1;
+    }
+    return contador;
+}
+
+// Función auxiliar recursiva para contar nodos (mantiene el cerrojo mientras baja)
+int ArbolConcurrente::obtenerNumeroNodos(const NodoConcurrente* nodo) {
+    std::shared_lock<std::shared_mutex> cerrojo(nodo->cerrojo);
+
+    int contador = 1; // Contar el nodo actual
+    for (const NodoConcurrente* hijo : nodo->hijos) {
+        contador += obtenerNumeroNodos(hijo);
+    }
+
+    return contador;
+}
@@ -0,0 +1,739 @@
+#include "arbol_paginado.h"
+#include "tree.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const std::uint64_t ID_RAIZ = 1;
+const size_t CAPACIDAD_MINIMA = 8;      // Una inserción fija a lo sumo tres páginas a la vez
+const size_t LARGO_MAXIMO_NOMBRE = 255; // NAME_MAX: garantiza varios registros por página
+const char MAGIA_ARCHIVO[8] = {'A', 'R', 'B', 'O', 'L', 'P', 'G', '2'};
+const size_t LARGO_CABECERA_ARCHIVO = 32; // Magia, raíz, páginas, siguiente id y entradas; luego su suma
+const size_t TAMANO_PAGINA = PoolPaginas::TAMANO_PAGINA;
+
+// Cabecera de cada página del árbol B+. Tras ella va el arreglo de desplazamientos (uint16) de los
+// registros en orden de clave; los registros (largo, clave, valor) crecen desde el final de la página.
+struct CabeceraPagina {
+    std::uint8_t esHoja;
+    std::uint8_t reservado;
+    std::uint16_t numClaves;
+    std::uint32_t enlace; // Hoja: hoja siguiente (0 = ninguna). Interna: hijo de las claves menores a la primera
+};
+
+struct EntradaPagina {
+    std::string clave;
+    std::uint64_t valor; // Hoja: id del nodo. Interna: página hija con claves >= clave
+};
+
+CabeceraPagina leerCabeceraPagina(const unsigned char* datos) {
+    CabeceraPagina cabecera;
+    std::memcpy(&cabecera, datos, sizeof(cabecera));
+    return cabecera;
+}
+
+std::uint16_t desplazamientoRegistro(const unsigned char* datos, size_t indice) {
+    std::uint16_t desplazamiento;
+    std::memcpy(&desplazamiento, datos + sizeof(CabeceraPagina) + 2 * indice, 2);
+    return desplazamiento;
+}
+
+std::string_view claveEn(const unsigned char* datos, size_t indice) {
+    std::uint16_t desplazamiento = desplazamientoRegistro(datos, indice);
+    std::uint16_t largo;
+    std::memcpy(&largo, datos + desplazamiento, 2);
+    return std::string_view(reinterpret_cast<const char*>(datos + desplazamiento + 2), largo);
+}
+
+std::uint64_t valorEn(const unsigned char* datos, size_t indice) {
+    std::uint16_t desplazamiento = desplazamientoRegistro(datos, indice);
+    std::uint16_t largo;
+    std::memcpy(&largo, datos + desplazamiento, 2);
+    std::uint64_t valor;
+    std::memcpy(&valor, datos + desplazamiento + 2 + largo, 8);
+    return valor;
+}
+
+// Bytes que ocupa una entrada en la página: desplazamiento + largo + clave + valor
+size_t tamanoRegistro(const EntradaPagina& entrada) {
+    return 2 + 2 + entrada.clave.size() + 8;
+}
+
+std::vector<EntradaPagina> decodificar(const unsigned char* datos) {
+    CabeceraPagina cabecera = leerCabeceraPagina(datos);
+    std::vector<EntradaPagina> entradas;
+    entradas.reserve(cabecera.numClaves + 1u);
+    for (size_t i = 0; i < cabecera.numClaves; ++i) {
+        entradas.push_back({std::string(claveEn(datos, i)), valorEn(datos, i)});
+    }
+    return entradas;
+}
+
+// Reescribe la página completa; retorna false (sin tocarla) si las entradas no caben
+bool codificar(unsigned char* datos, bool esHoja, std::uint32_t enlace, const std::vector<EntradaPagina>& entradas) {
+    size_t total = sizeof(CabeceraPagina);
+    for (const EntradaPagina& entrada : entradas) {
+        total += tamanoRegistro(entrada);
+    }
+    if (total > TAMANO_PAGINA) return false;
+
+    CabeceraPagina cabecera{static_cast<std::uint8_t>(esHoja ? 1 : 0), 0,
+                            static_cast<std::uint16_t>(entradas.size()), enlace};
+    std::memcpy(datos, &cabecera, sizeof(cabecera));
+
+    size_t fin = TAMANO_PAGINA;
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        const EntradaPagina& entrada = entradas[i];
+        fin -= 2 + entrada.clave.size() + 8;
+        std::uint16_t largo = static_cast<std::uint16_t>(entrada.clave.size());
+        std::uint16_t desplazamiento = static_cast<std::uint16_t>(fin);
+        std::memcpy(datos + fin, &largo, 2);
+        std::memcpy(datos + fin + 2, entrada.clave.data(), entrada.clave.size());
+        std::memcpy(datos + fin + 2 + entrada.clave.size(), &entrada.valor, 8);
+        std::memcpy(datos + sizeof(CabeceraPagina) + 2 * i, &desplazamiento, 2);
+    }
+    return true;
+}
+
+// Primera posición con clave >= buscada (o > buscada si 'estricta')
+size_t buscarPosicion(const unsigned char* datos, size_t numClaves, std::string_view clave, bool estricta) {
+    size_t izquierda = 0, derecha = numClaves;
+    while (izquierda < derecha) {
+        size_t medio = (izquierda + derecha) / 2;
+        std::string_view actual = claveEn(datos, medio);
+        if (actual < clave || (estricta && actual == clave)) {
+            izquierda = medio + 1;
+        } else {
+            derecha = medio;
+        }
+    }
+    return izquierda;
+}
+
+// Página hija de una página interna donde debe estar 'clave'
+std::uint32_t hijoPara(const unsigned char* datos, std::string_view clave) {
+    CabeceraPagina cabecera = leerCabeceraPagina(datos);
+    size_t posicion = buscarPosicion(datos, cabecera.numClaves, clave, true);
+    return posicion == 0 ? cabecera.enlace : static_cast<std::uint32_t>(valorEn(datos, posicion - 1));
+}
+
+// Clave (padre, nombre): el id va en big-endian para que el orden de bytes agrupe a los hermanos
+std::string construirClave(std::uint64_t padre, std::string_view nombre) {
+    std::string clave(8, '\0');
+    for (int i = 0; i < 8; ++i) {
+        clave[static_cast<size_t>(i)] = static_cast<char>((padre >> (56 - 8 * i)) & 0xFF);
+    }
+    clave.append(nombre);
+    return clave;
+}
+
+std::uint64_t padreDeClave(std::string_view clave) {
+    std::uint64_t padre = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        padre = (padre << 8) | static_cast<unsigned char>(clave[i]);
+    }
+    return padre;
+}
+
+bool nombresValidos(const std::vector<std::string>& componentes) {
+    return std::all_of(componentes.begin(), componentes.end(), [](const std::string& componente) {
+        return componente.size() <= LARGO_MAXIMO_NOMBRE;
+    });
+}
+
+// Página fijada en el pool mientras vive el objeto
+class PaginaFijada {
+private:
+    PoolPaginas& pool;
+    std::uint32_t pagina;
+    bool sucia;
+
+public:
+    unsigned char* datos;
+
+    // 'datos' queda en nullptr si no se pudo fijar: el llamador debe comprobarlo
+    PaginaFijada(PoolPaginas& poolPaginas, std::uint32_t numero, bool nueva = false)
+        : pool(poolPaginas), pagina(numero), sucia(nueva), datos(poolPaginas.fijar(numero, nueva)) {}
+    ~PaginaFijada() {
+        if (datos) pool.soltar(pagina, sucia);
+    }
+    PaginaFijada(const PaginaFijada&) = delete;
+    PaginaFijada& operator=(const PaginaFijada&) = delete;
+
+    void marcarSucia() { sucia = true; }
+};
+
+// Suma FNV-1a de 64 bits de la cabecera del archivo
+std::uint64_t sumaCabecera(const unsigned char* datos) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < LARGO_CABECERA_ARCHIVO; ++i) {
+        hash = (hash ^ datos[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+// Constructor del pool: reserva 'capacidad' marcos alineados a página
+PoolPaginas::PoolPaginas(int descriptor, size_t capacidad)
+    : fd(descriptor), memoria(nullptr), manecilla(0), lecturas(0), escrituras(0), aciertos(0) {
+    memoria = static_cast<unsigned char*>(std::aligned_alloc(TAMANO_PAGINA, capacidad * TAMANO_PAGINA));
+    marcos.resize(capacidad);
+    for (size_t i = 0; i < capacidad; ++i) {
+        marcos[i] = {0, 0, false, false, memoria + i * TAMANO_PAGINA};
+    }
+    residentes.reserve(capacidad);
+}
+
+// Destructor del pool: escribe las páginas sucias
+PoolPaginas::~PoolPaginas() {
+    vaciar();
+    std::free(memoria);
+}
+
+// Función para elegir un marco a reemplazar con el algoritmo del reloj; retorna capacidad()
+// si todos están fijados
+size_t PoolPaginas::elegirVictima() {
+    for (size_t paso = 0; paso < 2 * marcos.size() + 1; ++paso) {
+        size_t actual = manecilla;
+        MarcoPagina& marco = marcos[actual];
+        manecilla = (manecilla + 1) % marcos.size();
+
+        if (marco.fijaciones > 0) continue;
+        if (marco.pagina == 0) return actual;
+        if (marco.referenciada) {
+            marco.referenciada = false; // Segunda oportunidad
+            continue;
+        }
+        return actual;
+    }
+
+    std::cerr << "Pool de páginas agotado: todos los marcos están fijados" << std::endl;
+    return marcos.size();
+}
+
+// Función para escribir un marco en su página; si falla el marco sigue sucio
+bool PoolPaginas::escribirMarco(MarcoPagina& marco) {
+    off_t posicion = static_cast<off_t>(marco.pagina) * static_cast<off_t>(TAMANO_PAGINA);
+    ssize_t escritos;
+    do {
+        escritos = pwrite(fd, marco.datos, TAMANO_PAGINA, posicion);
+    } while (escritos < 0 && errno == EINTR);
+    if (escritos != static_cast<ssize_t>(TAMANO_PAGINA)) {
+        std::cerr << "Error al escribir la página " << marco.pagina << ": "
+                  << (escritos < 0 ? std::strerror(errno) : "escritura incompleta") << std::endl;
+        return false;
+    }
+    escrituras++;
+    marco.sucia = false;
+    return true;
+}
+
+// Función para fijar una página en memoria (leyéndola si no está); 'nueva' la crea en ceros sin leer.
+// Retorna nullptr si el pool está agotado o falla la E/S
+unsigned char* PoolPaginas::fijar(std::uint32_t pagina, bool nueva) {
+    auto it = residentes.find(pagina);
+    if (it != residentes.end()) {
+        MarcoPagina& marco = marcos[it->second];
+        marco.fijaciones++;
+        marco.referenciada = true;
+        aciertos++;
+        return marco.datos;
+    }
+
+    size_t indice = elegirVictima();
+    if (indice == marcos.size()) return nullptr;
+    MarcoPagina& marco = marcos[indice];
+    if (marco.pagina != 0) {
+        if (marco.sucia && !escribirMarco(marco)) return nullptr;
+        residentes.erase(marco.pagina);
+    }
+
+    marco.pagina = pagina;
+    marco.fijaciones = 1;
+    marco.sucia = false;
+    marco.referenciada = true;
+    if (nueva) {
+        std::memset(marco.datos, 0, TAMANO_PAGINA);
+    } else {
+        off_t posicion = static_cast<off_t>(pagina) * static_cast<off_t>(TAMANO_PAGINA);
+        ssize_t leidos;
+        do {
+            leidos = pread(fd, marco.datos, TAMANO_PAGINA, posicion);
+        } while (leidos < 0 && errno == EINTR);
+        if (leidos != static_cast<ssize_t>(TAMANO_PAGINA)) {
+            std::cerr << "Error al leer la página " << pagina << ": "
+                      << (leidos < 0 ? std::strerror(errno) : "página incompleta") << std::endl;
+            marco.pagina = 0; // El marco queda libre
+            marco.fijaciones = 0;
+            return nullptr;
+        }
+        lecturas++;
+    }
+    residentes[pagina] = indice;
+    return marco.datos;
+}
+
+void PoolPaginas::soltar(std::uint32_t pagina, bool sucia) {
+    MarcoPagina& marco = marcos[residentes.at(pagina)];
+    marco.fijaciones--;
+    if (sucia) marco.sucia = true;
+}
+
+// Función para escribir todas las páginas sucias (quedan residentes y limpias); retorna false
+// si alguna no pudo escribirse
+bool PoolPaginas::vaciar() {
+    bool exito = true;
+    for (MarcoPagina& marco : marcos) {
+        if (marco.pagina != 0 && marco.sucia && !escribirMarco(marco)) {
+            exito = false;
+        }
+    }
+    return exito;
+}
+
+// Función para olvidar las modificaciones pendientes (el destructor ya no las escribirá)
+void PoolPaginas::descartar() {
+    for (MarcoPagina& marco : marcos) {
+        marco.sucia = false;
+    }
+}
+
+size_t PoolPaginas::capacidad() const {
+    return marcos.size();
+}
+
+long long PoolPaginas::obtenerLecturas() const {
+    return lecturas;
+}
+
+long long PoolPaginas::obtenerEscrituras() const {
+    return escrituras;
+}
+
+long long PoolPaginas::obtenerAciertos() const {
+    return aciertos;
+}
+
+void PoolPaginas::reiniciarContadores() {
+    lecturas = 0;
+    escrituras = 0;
+    aciertos = 0;
+}
+
+// Constructor del árbol: crea (o vacía) el archivo de páginas con una hoja raíz vacía, o con
+// AperturaPaginado::Abrir retoma uno existente validando su cabecera
+ArbolPaginado::ArbolPaginado(const std::string& rutaArchivo, size_t paginasEnMemoria, bool entradaSalidaDirecta,
+                             AperturaPaginado apertura)
+    : fd(-1), pool(nullptr), paginaRaiz(1), numPaginas(2), siguienteId(ID_RAIZ + 1), numEntradas(0), directa(false),
+      fallo(false) {
+    bool crear = apertura == AperturaPaginado::Crear;
+    int banderas = O_RDWR | O_CLOEXEC | (crear ? O_CREAT | O_TRUNC : 0);
+    if (entradaSalidaDirecta) {
+        fd = open(rutaArchivo.c_str(), banderas | O_DIRECT, 0644);
+        directa = fd >= 0;
+    }
+    if (fd < 0) {
+        fd = open(rutaArchivo.c_str(), banderas, 0644); // Sistemas de archivos sin O_DIRECT (p. ej. tmpfs)
+    }
+    if (fd < 0) {
+        std::cerr << "Error al " << (crear ? "crear" : "abrir") << " el archivo de páginas " << rutaArchivo << ": "
+                  << std::strerror(errno) << std::endl;
+        return;
+    }
+    if (!crear && !cargarCabecera(rutaArchivo)) {
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    pool = new PoolPaginas(fd, std::max(paginasEnMemoria, CAPACIDAD_MINIMA));
+    if (crear) {
+        PaginaFijada raiz(*pool, paginaRaiz, true);
+        codificar(raiz.datos, true, 0, {}); // Un pool recién creado siempre tiene marcos libres
+    }
+}
+
+// Destructor del árbol: deja el archivo consistente en disco
+ArbolPaginado::~ArbolPaginado() {
+    if (pool) {
+        if (!vaciar()) {
+            pool->descartar(); // Tras un error no se escriben páginas a medio modificar
+        }
+        delete pool;
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool ArbolPaginado::abierto() const {
+    return pool != nullptr;
+}
+
+bool ArbolPaginado::tieneError() const {
+    return fallo;
+}
+
+// Función para dejar el árbol detenido tras un error de E/S; retorna false para propagarlo
+bool ArbolPaginado::marcarFallo() {
+    fallo = true;
+    return false;
+}
+
+bool ArbolPaginado::usaEntradaSalidaDirecta() const {
+    return directa;
+}
+
+std::uint32_t ArbolPaginado::nuevaPagina() {
+    return numPaginas++;
+}
+
+// Función para escribir la cabecera del archivo (página 0) con la raíz, los contadores y su suma
+bool ArbolPaginado::guardarCabecera() {
+    unsigned char* buffer = static_cast<unsigned char*>(std::aligned_alloc(TAMANO_PAGINA, TAMANO_PAGINA));
+    std::memset(buffer, 0, TAMANO_PAGINA);
+    std::memcpy(buffer, MAGIA_ARCHIVO, sizeof(MAGIA_ARCHIVO));
+    std::memcpy(buffer + 8, &paginaRaiz, sizeof(paginaRaiz));
+    std::memcpy(buffer + 12, &numPaginas, sizeof(numPaginas));
+    std::memcpy(buffer + 16, &siguienteId, sizeof(siguienteId));
+    std::memcpy(buffer + 24, &numEntradas, sizeof(numEntradas));
+    std::uint64_t suma = sumaCabecera(buffer);
+    std::memcpy(buffer + LARGO_CABECERA_ARCHIVO, &suma, sizeof(suma));
+    bool exito = pwrite(fd, buffer, TAMANO_PAGINA, 0) == static_cast<ssize_t>(TAMANO_PAGINA);
+    if (!exito) {
+        std::cerr << "Error al escribir la cabecera del archivo de páginas: " << std::strerror(errno) << std::endl;
+    }
+    std::free(buffer);
+    return exito;
+}
+
+// Función para leer y validar la cabecera de un archivo existente; retorna false si no es un
+// archivo de páginas, está corrupto o es más corto de lo que dice su cabecera
+bool ArbolPaginado::cargarCabecera(const std::string& rutaArchivo) {
+    unsigned char* buffer = static_cast<unsigned char*>(std::aligned_alloc(TAMANO_PAGINA, TAMANO_PAGINA));
+    ssize_t leidos = pread(fd, buffer, TAMANO_PAGINA, 0);
+    bool valida = leidos == static_cast<ssize_t>(TAMANO_PAGINA) &&
+                  std::memcmp(buffer, MAGIA_ARCHIVO, sizeof(MAGIA_ARCHIVO)) == 0;
+    if (valida) {
+        std::uint64_t suma;
+        std::memcpy(&suma, buffer + LARGO_CABECERA_ARCHIVO, sizeof(suma));
+        std::memcpy(&paginaRaiz, buffer + 8, sizeof(paginaRaiz));
+        std::memcpy(&numPaginas, buffer + 12, sizeof(numPaginas));
+        std::memcpy(&siguienteId, buffer + 16, sizeof(siguienteId));
+        std::memcpy(&numEntradas, buffer + 24, sizeof(numEntradas));
+        off_t largoArchivo = lseek(fd, 0, SEEK_END);
+        valida = suma == sumaCabecera(buffer) && numPaginas >= 2 && paginaRaiz >= 1 && paginaRaiz < numPaginas &&
+                 siguienteId > ID_RAIZ && numEntradas >= 0 &&
+                 largoArchivo >= static_cast<off_t>(numPaginas) * static_cast<off_t>(TAMANO_PAGINA);
+    }
+    std::free(buffer);
+
+    if (!valida) {
+        std::cerr << "El archivo de páginas " << rutaArchivo << " no tiene una cabecera válida" << std::endl;
+    }
+    return valida;
+}
+
+// Función para buscar una clave exacta bajando de la raíz a una hoja (una página fijada a la vez)
+// (false también si falla la E/S, lo que deja 'fallo' activo)
+bool ArbolPaginado::buscarEntrada(const std::string& clave, std::uint64_t& valor) {
+    std::uint32_t pagina = paginaRaiz;
+    while (true) {
+        PaginaFijada fijada(*pool, pagina);
+        if (!fijada.datos) return marcarFallo();
+        CabeceraPagina cabecera = leerCabeceraPagina(fijada.datos);
+        if (!cabecera.esHoja) {
+            pagina = hijoPara(fijada.datos, clave);
+            continue;
+        }
+
+        size_t posicion = buscarPosicion(fijada.datos, cabecera.numClaves, clave, false);
+        if (posicion < cabecera.numClaves && claveEn(fijada.datos, posicion) == clave) {
+            valor = valorEn(fijada.datos, posicion);
+            return true;
+        }
+        return false;
+    }
+}
+
+// Función para insertar en el subárbol de 'pagina'; retorna true si la página se dividió y deja en
+// 'separador'/'paginaDerecha' la clave y la página nuevas que el padre debe incorporar. Ante un
+// error de E/S retorna false con 'fallo' activo
+bool ArbolPaginado::insertarEnSubarbol(std::uint32_t pagina, const std::string& clave, std::uint64_t valor,
+                                       std::string& separador, std::uint32_t& paginaDerecha) {
+    std::uint32_t hijo = 0;
+    {
+        PaginaFijada fijada(*pool, pagina);
+        if (!fijada.datos) return marcarFallo();
+        if (!leerCabeceraPagina(fijada.datos).esHoja) {
+            hijo = hijoPara(fijada.datos, clave);
+        }
+    }
+
+    EntradaPagina nueva{clave, valor};
+    if (hijo != 0) {
+        std::string separadorHijo;
+        std::uint32_t derechaHijo;
+        if (!insertarEnSubarbol(hijo, clave, valor, separadorHijo, derechaHijo)) return false;
+        nueva = {separadorHijo, derechaHijo}; // La división del hijo agrega una clave a esta página
+    }
+
+    PaginaFijada fijada(*pool, pagina);
+    if (!fijada.datos) return marcarFallo();
+    CabeceraPagina cabecera = leerCabeceraPagina(fijada.datos);
+    std::vector<EntradaPagina> entradas = decodificar(fijada.datos);
+    auto it = std::upper_bound(entradas.begin(), entradas.end(), nueva.clave,
+        [](const std::string& a, const EntradaPagina& b) {
+            return a < b.clave;
+        });
+    entradas.insert(it, nueva);
+    fijada.marcarSucia();
+    if (codificar(fijada.datos, cabecera.esHoja, cabecera.enlace, entradas)) return false;
+
+    // No cabe: dividir en dos mitades de bytes parecidos
+    size_t total = 0;
+    for (const EntradaPagina& entrada : entradas) {
+        total += tamanoRegistro(entrada);
+    }
+    size_t corte = 0, acumulado = 0;
+    while (corte < entradas.size() && acumulado + tamanoRegistro(entradas[corte]) <= total / 2) {
+        acumulado += tamanoRegistro(entradas[corte]);
+        corte++;
+    }
+    corte = std::clamp<size_t>(corte, 1, entradas.size() - 2);
+
+    paginaDerecha = nuevaPagina();
+    PaginaFijada derecha(*pool, paginaDerecha, true);
+    if (!derecha.datos) return marcarFallo();
+    std::vector<EntradaPagina> izquierdas(entradas.begin(), entradas.begin() + static_cast<long>(corte));
+    if (cabecera.esHoja) {
+        std::vector<EntradaPagina> derechas(entradas.begin() + static_cast<long>(corte), entradas.end());
+        separador = derechas.front().clave;
+        codificar(derecha.datos, true, cabecera.enlace, derechas);
+        codificar(fijada.datos, true, paginaDerecha, izquierdas);
+    } else {
+        // La clave del medio sube al padre y su página pasa a ser el enlace de la página derecha
+        const EntradaPagina& medio = entradas[corte];
+        separador = medio.clave;
+        std::vector<EntradaPagina> derechas(entradas.begin() + static_cast<long>(corte) + 1, entradas.end());
+        codificar(derecha.datos, false, static_cast<std::uint32_t>(medio.valor), derechas);
+        codificar(fijada.datos, false, cabecera.enlace, izquierdas);
+    }
+    return true;
+}
+
+// Función para insertar una clave nueva, haciendo crecer el árbol B+ si la raíz se divide
+void ArbolPaginado::insertarEntrada(const std::string& clave, std::uint64_t valor) {
+    std::string separador;
+    std::uint32_t paginaDerecha;
+    if (insertarEnSubarbol(paginaRaiz, clave, valor, separador, paginaDerecha)) {
+        std::uint32_t nuevaRaiz = nuevaPagina();
+        PaginaFijada raiz(*pool, nuevaRaiz, true);
+        if (!raiz.datos) {
+            marcarFallo();
+            return;
+        }
+        codificar(raiz.datos, false, paginaRaiz, {{separador, paginaDerecha}});
+        paginaRaiz = nuevaRaiz;
+    }
+    if (!fallo) {
+        numEntradas++;
+    }
+}
+
+// Función para borrar una clave de su hoja (sin fusionar páginas)
+bool ArbolPaginado::eliminarEntrada(const std::string& clave) {
+    std::uint32_t pagina = paginaRaiz;
+    while (true) {
+        PaginaFijada fijada(*pool, pagina);
+        if (!fijada.datos) return marcarFallo();
+        CabeceraPagina cabecera = leerCabeceraPagina(fijada.datos);
+        if (!cabecera.esHoja) {
+            pagina = hijoPara(fijada.datos, clave);
+            continue;
+        }
+
+        size_t posicion = buscarPosicion(fijada.datos, cabecera.numClaves, clave, false);
+        if (posicion >= cabecera.numClaves || claveEn(fijada.datos, posicion) != clave) return false;
+
+        std::vector<EntradaPagina> entradas = decodificar(fijada.datos);
+        entradas.erase(entradas.begin() + static_cast<long>(posicion));
+        codificar(fijada.datos, true, cabecera.enlace, entradas);
+        fijada.marcarSucia();
+        numEntradas--;
+        return true;
+    }
+}
+
+// Función para listar hasta 'maximo' hijos de un nodo recorriendo las hojas encadenadas (la lista
+// queda incompleta si falla la E/S, con 'fallo' activo)
+std::vector<std::pair<std::string, std::uint64_t>> ArbolPaginado::listarHijos(std::uint64_t id, size_t maximo) {
+    std::string inicio = construirClave(id, "");
+    std::uint32_t pagina = paginaRaiz;
+    while (true) {
+        PaginaFijada fijada(*pool, pagina);
+        if (!fijada.datos) {
+            marcarFallo();
+            return {};
+        }
+        if (leerCabeceraPagina(fijada.datos).esHoja) break;
+        pagina = hijoPara(fijada.datos, inicio);
+    }
+
+    std::vector<std::pair<std::string, std::uint64_t>> hijos;
+    bool primera = true;
+    while (pagina != 0) {
+        PaginaFijada fijada(*pool, pagina);
+        if (!fijada.datos) {
+            marcarFallo();
+            return hijos;
+        }
+        CabeceraPagina cabecera = leerCabeceraPagina(fijada.datos);
+        size_t posicion = primera ? buscarPosicion(fijada.datos, cabecera.numClaves, inicio, false) : 0;
+        primera = false;
+
+        for (; posicion < cabecera.numClaves; ++posicion) {
+            std::string_view clave = claveEn(fijada.datos, posicion);
+            if (padreDeClave(clave) != id || hijos.size() >= maximo) return hijos;
+            hijos.emplace_back(std::string(clave), valorEn(fijada.datos, posicion));
+        }
+        pagina = cabecera.enlace;
+    }
+    return hijos;
+}
+
+// Función para obtener el id del nodo al que llevan los primeros 'cuantos' componentes
+bool ArbolPaginado::resolver(const std::vector<std::string>& componentes, size_t cuantos, std::uint64_t& id) {
+    id = ID_RAIZ;
+    for (size_t i = 0; i < cuantos; ++i) {
+        if (!buscarEntrada(construirClave(id, componentes[i]), id)) return false;
+    }
+    return true;
+}
+
+// Función para borrar todas las entradas bajo un nodo (de las hojas hacia arriba)
+void ArbolPaginado::eliminarSubarbol(std::uint64_t id) {
+    for (const auto& [clave, hijo] : listarHijos(id, SIZE_MAX)) {
+        eliminarSubarbol(hijo);
+        if (fallo || !eliminarEntrada(clave)) return;
+    }
+}
+
+// Función para cargar datos del sistema de archivos sin mantener el árbol en memoria
+void ArbolPaginado::cargarDatos(const std::string& rutaBase) {
+    try {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(rutaBase)) {
+            std::string rutaRelativa = std::filesystem::relative(entry.path(), rutaBase).string();
+            insertarRuta(rutaRelativa);
+            if (fallo) return;
+        }
+    } catch (const std::filesystem::filesystem_error& e) {
+        std::cerr << "Error al acceder al sistema de archivos: " << e.what() << std::endl;
+    }
+}
+
+// Función para insertar una ruta creando los directorios intermedios que falten
+void ArbolPaginado::insertarRuta(const std::string& ruta) {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (fallo || !nombresValidos(componentes)) return;
+
+    std::uint64_t id = ID_RAIZ;
+    for (const std::string& componente : componentes) {
+        std::string clave = construirClave(id, componente);
+        if (!buscarEntrada(clave, id)) {
+            if (fallo) return;
+            id = siguienteId++;
+            insertarEntrada(clave, id);
+            if (fallo) return;
+        }
+    }
+}
+
+// Función de búsqueda por ruta (0 archivo, 1 no existe, 2 directorio, -1 error de E/S)
+int ArbolPaginado::buscar(const std::string& ruta) {
+    if (fallo) return -1;
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    std::uint64_t id;
+    if (!resolver(componentes, componentes.size(), id)) return fallo ? -1 : 1; // No existe
+    bool hoja = listarHijos(id, 1).empty();
+    if (fallo) return -1;
+    return hoja ? 0 : 2;
+}
+
+// Función para insertar un nuevo archivo/directorio (0 éxito, 1 ya existe, 2 ruta inválida,
+// 3 error de E/S)
+int ArbolPaginado::insertar(const std::string& ruta) {
+    if (fallo) return 3;
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (componentes.empty() || !nombresValidos(componentes)) return 2; // Ruta inválida
+
+    std::uint64_t padre, existente;
+    if (!resolver(componentes, componentes.size() - 1, padre)) return fallo ? 3 : 2; // No existe la ruta padre
+
+    std::string clave = construirClave(padre, componentes.back());
+    if (buscarEntrada(clave, existente)) return 1; // Ya existe
+    if (fallo) return 3;
+
+    insertarEntrada(clave, siguienteId++);
+    return fallo ? 3 : 0;
+}
+
+// Función para eliminar un archivo/directorio junto con su subárbol (false si no existe o
+// falla la E/S)
+bool ArbolPaginado::eliminar(const std::string& ruta) {
+    std::vector<std::string> componentes = ArbolSistemaArchivos::dividirRuta(ruta);
+    if (fallo || componentes.empty()) return false;
+
+    std::uint64_t padre, id;
+    if (!resolver(componentes, componentes.size() - 1, padre)) return false;
+
+    std::string clave = construirClave(padre, componentes.back());
+    if (!buscarEntrada(clave, id)) return false;
+
+    eliminarSubarbol(id);
+    return !fallo && eliminarEntrada(clave);
+}
+
+// Función para obtener el número total de nodos (la raíz no tiene entrada propia)
+long long ArbolPaginado::obtenerNumeroNodos() const {
+    return numEntradas + 1;
+}
+
+long long ArbolPaginado::obtenerNumeroPaginas() const {
+    return numPaginas;
+}
+
+// Función para reemplazar el pool por uno de otra capacidad (empieza frío)
+void ArbolPaginado::cambiarCapacidad(size_t paginasEnMemoria) {
+    if (!vaciar()) {
+        pool->descartar();
+    }
+    delete pool;
+    pool = new PoolPaginas(fd, std::max(paginasEnMemoria, CAPACIDAD_MINIMA));
+    if (!directa) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED); // Sin O_DIRECT, que la caché del kernel no oculte la E/S
+    }
+}
+
+// Función para escribir en disco las páginas sucias y luego la cabecera que las describe
+// (tras un error no se escribe nada más)
+bool ArbolPaginado::vaciar() {
+    if (fallo || !pool->vaciar()) return marcarFallo();
+    return guardarCabecera() || marcarFallo();
+}
+
+const PoolPaginas& ArbolPaginado::obtenerPool() const {
+    return *pool;
+}
+
+void ArbolPaginado::reiniciarContadores() {
+    pool->reiniciarContadores();
+}
@@ -0,0 +1,413 @@
+// Benchmark de núcleos de búsqueda en arreglos ordenados (objetivo 'make bench_busqueda').
+// Compara la búsqueda binaria estándar, la binaria sin saltos, el orden Eytzinger con precarga y
+// los nodos de árbol B estático, con claves enteras y con nombres de hijos, para tamaños que van
+// desde caber en L1 hasta vivir en DRAM. Con nombres mide además el índice que usa buscarHijo.
+//
+// Uso: ./bin/bench_busqueda [directorio]
+//   Si se pasa un directorio, los nombres salen de sus entradas reales; si no, se generan como
+//   los de create_files.bash (file_N.ext y dir_N).
+
+#include "tree.h"
+#include "indice_hijos.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+const size_t CONSULTAS = 1 << 20;   // Búsquedas por medición
+const double PROPORCION_FALLOS = 0.1; // Consultas que no existen en el arreglo
+
+// Precarga de una dirección que puede quedar fuera del arreglo (no se desreferencia)
+template <typename T>
+void precargar(const T* base, size_t desplazamiento) {
+    __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(base) + desplazamiento * sizeof(T)));
+}
+
+// Búsqueda binaria estándar (con saltos), como buscarHijo en directorios chicos
+template <typename T>
+class BusquedaEstandar {
+private:
+    std::vector<T> datos;
+
+public:
+    explicit BusquedaEstandar(const std::vector<T>& ordenados) : datos(ordenados) {}
+
+    bool buscar(const T& x) const {
+        auto it = std::lower_bound(datos.begin(), datos.end(), x);
+        return it != datos.end() && !(x < *it);
+    }
+};
+
+// Búsqueda binaria sin saltos: el rango se achica con un movimiento condicional y siempre tarda
+// log2(n) pasos; precarga los dos posibles puntos medios siguientes
+template <typename T>
+class BusquedaSinSaltos {
+private:
+    std::vector<T> datos;
+
+public:
+    explicit BusquedaSinSaltos(const std::vector<T>& ordenados) : datos(ordenados) {}
+
+    bool buscar(const T& x) const {
+        const T* base = datos.data();
+        size_t largo = datos.size();
+        while (largo > 1) {
+            size_t mitad = largo / 2;
+            precargar(base, largo / 4 - 1);
+            precargar(base, mitad + largo / 4 - 1);
+            base += (base[mitad - 1] < x) ? mitad : 0;
+            largo -= mitad;
+        }
+        return !(*base < x) && !(x < *base);
+    }
+};
+
+// Orden Eytzinger (BFS, base 1): los nodos de los próximos niveles quedan contiguos y se precargan
+template <typename T>
+class BusquedaEytzinger {
+private:
+    std::vector<T> datos;
+    size_t adelanto;
+
+    void construir(const std::vector<T>& ordenados, size_t& siguiente, size_t k) {
+        if (k < datos.size()) {
+            construir(ordenados, siguiente, 2 * k);
+            datos[k] = ordenados[siguiente++];
+            construir(ordenados, siguiente, 2 * k + 1);
+        }
+    }
+
+public:
+    explicit BusquedaEytzinger(const std::vector<T>& ordenados)
+        : datos(ordenados.size() + 1), adelanto(std::max<size_t>(1, 64 / sizeof(T))) {
+        size_t siguiente = 0;
+        construir(ordenados, siguiente, 1);
+    }
+
+    bool buscar(const T& x) const {
+        const T* base = datos.data();
+        size_t n = datos.size() - 1;
+        size_t k = 1;
+        while (k <= n) {
+            precargar(base, k * adelanto);
+            k = 2 * k + (base[k] < x);
+        }
+        k >>= std::countr_one(k) + 1;
+        return k != 0 && !(x < base[k]);
+    }
+};
+
+// Árbol B estático: nodos de B claves contiguas (un bloque de caché para enteros); en cada nodo se
+// cuentan las claves menores sin saltos y se baja al hijo correspondiente
+template <typename T>
+class BusquedaArbolB {
+private:
+    static const size_t B = 16;
+    std::vector<T> datos;
+    size_t numBloques;
+
+    static size_t hijo(size_t k, size_t i) { return k * (B + 1) + i + 1; }
+
+    void construir(const std::vector<T>& ordenados, size_t& siguiente, size_t k, const T& infinito) {
+        if (k < numBloques) {
+            for (size_t i = 0; i < B; ++i) {
+                construir(ordenados, siguiente, hijo(k, i), infinito);
+                datos[k * B + i] = siguiente < ordenados.size() ? ordenados[siguiente++] : infinito;
+            }
+            construir(ordenados, siguiente, hijo(k, B), infinito);
+        }
+    }
+
+public:
+    BusquedaArbolB(const std::vector<T>& ordenados, const T& infinito)
+        : numBloques((ordenados.size() + B - 1) / B) {
+        datos.assign(numBloques * B, infinito);
+        size_t siguiente = 0;
+        construir(ordenados, siguiente, 0, infinito);
+    }
+
+    bool buscar(const T& x) const {
+        const T* candidato = nullptr;
+        size_t k = 0;
+        while (k < numBloques) {
+            const T* nodo = &datos[k * B];
+            size_t menores = 0;
+            for (size_t i = 0; i < B; ++i) {
+                menores += (nodo[i] < x);
+            }
+            if (menores < B) candidato = &nodo[menores];
+            k = hijo(k, menores);
+        }
+        return candidato && !(x < *candidato);
+    }
+};
+
+// Búsqueda binaria sobre punteros a nodos: lo que hacía buscarHijo en todos los directorios
+// (cada paso desreferencia un nodo para leer su nombre)
+class BusquedaNodos {
+private:
+    NodoArbol padre;
+
+public:
+    explicit BusquedaNodos(const std::vector<std::string>& ordenados) : padre("bench") {
+        padre.hijos.reserve(ordenados.size());
+        for (const std::string& nombre : ordenados) {
+            padre.hijos.push_back(new NodoArbol(nombre));
+        }
+    }
+
+    bool buscar(const std::string& x) const {
+        int izq = 0, der = static_cast<int>(padre.hijos.size()) - 1;
+        while (izq <= der) {
+            int medio = izq + (der - izq) / 2;
+            const std::string& nombre = padre.hijos[static_cast<size_t>(medio)]->nombre;
+            if (nombre == x) {
+                return true;
+            } else if (nombre < x) {
+                izq = medio + 1;
+            } else {
+                der = medio - 1;
+            }
+        }
+        return false;
+    }
+};
+
+// Índice de buscarHijo sobre nodos reales: claves de 16 bytes en Eytzinger más desempate por nombre
+class BusquedaIndiceArbol {
+private:
+    NodoArbol padre;
+    IndiceHijos indice;
+
+public:
+    explicit BusquedaIndiceArbol(const std::vector<std::string>& ordenados) : padre("bench") {
+        padre.hijos.reserve(ordenados.size());
+        for (const std::string& nombre : ordenados) {
+            padre.hijos.push_back(new NodoArbol(nombre));
+        }
+        while (!indice.preparar(padre.hijos)) {}
+    }
+
+    bool buscar(const std::string& x) const {
+        return indice.buscar(padre.hijos, x) != nullptr;
+    }
+};
+
+// buscarHijo completo: elige índice o búsqueda binaria según el tamaño del directorio y la
+// medición incluye la construcción perezosa del índice
+class BusquedaBuscarHijo {
+private:
+    ArbolSistemaArchivos arbol;
+    NodoArbol padre;
+
+public:
+    explicit BusquedaBuscarHijo(const std::vector<std::string>& ordenados) : padre("bench") {
+        padre.hijos.reserve(ordenados.size());
+        for (const std::string& nombre : ordenados) {
+            padre.hijos.push_back(new NodoArbol(nombre));
+        }
+    }
+
+    bool buscar(const std::string& x) {
+        return arbol.buscarHijo(&padre, x) != nullptr;
+    }
+};
+
+// Función para medir ns por búsqueda; 'encontrados' sirve para comprobar que todos coinciden
+template <typename Busqueda, typename T>
+double medir(Busqueda& busqueda, const std::vector<T>& consultas, long long& encontrados) {
+    encontrados = 0;
+    auto inicio = std::chrono::high_resolution_clock::now();
+    for (const T& consulta : consultas) {
+        encontrados += busqueda.buscar(consulta);
+    }
+    auto fin = std::chrono::high_resolution_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count()) /
+           static_cast<double>(consultas.size());
+}
+
+// Función para armar las consultas: existentes al azar más una fracción de ausentes
+template <typename T, typename Ausente>
+std::vector<T> generarConsultas(const std::vector<T>& ordenados, std::mt19937_64& gen, Ausente ausente) {
+    std::uniform_int_distribution<size_t> distIndice(0, ordenados.size() - 1);
+    std::uniform_real_distribution<double> distFallo(0.0, 1.0);
+    std::vector<T> consultas;
+    consultas.reserve(CONSULTAS);
+    for (size_t i = 0; i < CONSULTAS; ++i) {
+        const T& base = ordenados[distIndice(gen)];
+        consultas.push_back(distFallo(gen) < PROPORCION_FALLOS ? ausente(base) : base);
+    }
+    return consultas;
+}
+
+std::string formatoBytes(double bytes) {
+    const char* unidades[] = {"B", "KiB", "MiB", "GiB"};
+    int unidad = 0;
+    while (bytes >= 1024.0 && unidad < 3) {
+        bytes /= 1024.0;
+        unidad++;
+    }
+    std::ostringstream salida;
+    salida << std::fixed << std::setprecision(bytes < 10.0 ? 1 : 0) << bytes << " " << unidades[unidad];
+    return salida.str();
+}
+
+// Función para comparar los núcleos con claves enteras de 32 bits
+void compararEnteros() {
+    std::cout << "\n=== CLAVES ENTERAS (int32, " << CONSULTAS << " búsquedas por celda, ns/búsqueda) ===" << std::endl;
+    std::cout << std::left << std::setw(11) << "n"
+              << std::setw(11) << "Datos"
+              << std::setw(11) << "Estándar"
+              << std::setw(12) << "Sin saltos"
+              << std::setw(11) << "Eytzinger"
+              << std::setw(11) << "Árbol B"
+              << std::setw(10) << "Correcto" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    std::mt19937_64 gen(42);
+    for (size_t n = 64; n <= (1u << 24); n *= 4) {
+        // Claves pares distintas: las impares sirven de consultas ausentes
+        std::uniform_int_distribution<int> distValor(0, 1 << 29);
+        std::vector<int> ordenados;
+        ordenados.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            ordenados.push_back(distValor(gen) * 2);
+        }
+        std::sort(ordenados.begin(), ordenados.end());
+        ordenados.erase(std::unique(ordenados.begin(), ordenados.end()), ordenados.end());
+        std::vector<int> consultas = generarConsultas(ordenados, gen, [](int x) { return x + 1; });
+
+        BusquedaEstandar<int> estandar(ordenados);
+        BusquedaSinSaltos<int> sinSaltos(ordenados);
+        BusquedaEytzinger<int> eytzinger(ordenados);
+        BusquedaArbolB<int> arbolB(ordenados, INT32_MAX);
+
+        long long e1, e2, e3, e4;
+        double t1 = medir(estandar, consultas, e1);
+        double t2 = medir(sinSaltos, consultas, e2);
+        double t3 = medir(eytzinger, consultas, e3);
+        double t4 = medir(arbolB, consultas, e4);
+
+        std::cout << std::left << std::setw(11) << ordenados.size()
+                  << std::setw(11) << formatoBytes(static_cast<double>(ordenados.size() * sizeof(int)))
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << t1 << std::setw(12) << t2 << std::setw(11) << t3 << std::setw(11) << t4
+                  << std::setw(10) << (e1 == e2 && e1 == e3 && e1 == e4 ? "sí" : "NO") << std::endl;
+    }
+}
+
+// Función para obtener nombres distintos: de un directorio real o al estilo de create_files.bash
+std::vector<std::string> obtenerNombres(const std::string& rutaDirectorio, size_t maximo) {
+    std::vector<std::string> nombres;
+    if (!rutaDirectorio.empty()) {
+        std::unordered_set<std::string> vistos;
+        try {
+            for (const auto& entrada : std::filesystem::recursive_directory_iterator(rutaDirectorio)) {
+                if (vistos.size() >= maximo) break;
+                vistos.insert(entrada.path().filename().string());
+            }
+        } catch (const std::filesystem::filesystem_error& e) {
+            std::cerr << "Error al acceder al sistema de archivos: " << e.what() << std::endl;
+        }
+        nombres.assign(vistos.begin(), vistos.end());
+    } else {
+        const std::vector<std::string> extensiones = {".txt", ".csv", ".cpp", ".c", ".json", ".xml",
+                                                      ".md", ".rs", ".py", ".js", ".lua"};
+        std::mt19937_64 gen(7);
+        for (size_t i = 1; i <= maximo; ++i) {
+            nombres.push_back(i % 8 == 0 ? "dir_" + std::to_string(i)
+                                         : "file_" + std::to_string(i) + extensiones[gen() % extensiones.size()]);
+        }
+    }
+    std::shuffle(nombres.begin(), nombres.end(), std::mt19937_64(3));
+    return nombres;
+}
+
+// Función para comparar los núcleos con nombres de hijos como claves
+void compararNombres(const std::string& rutaDirectorio) {
+    const size_t maximo = 1 << 20;
+    std::vector<std::string> todos = obtenerNombres(rutaDirectorio, maximo);
+    if (todos.size() < 2) {
+        std::cout << "No hay suficientes nombres para comparar." << std::endl;
+        return;
+    }
+
+    std::cout << "\n=== NOMBRES DE HIJOS (" << (rutaDirectorio.empty() ? "sintéticos" : rutaDirectorio)
+              << ", ns/búsqueda) ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "n"
+              << std::setw(11) << "Estándar"
+              << std::setw(12) << "Sin saltos"
+              << std::setw(11) << "Eytzinger"
+              << std::setw(10) << "Árbol B"
+              << std::setw(11) << "Nodos"
+              << std::setw(15) << "Índice árbol"
+              << std::setw(13) << "buscarHijo"
+              << std::setw(10) << "Correcto" << std::endl;
+    std::cout << std::string(103, '-') << std::endl;
+
+    std::mt19937_64 gen(42);
+    for (size_t n = 16;; n *= 4) {
+        n = std::min(n, todos.size());
+        std::vector<std::string> ordenados(todos.begin(), todos.begin() + static_cast<std::ptrdiff_t>(n));
+        std::sort(ordenados.begin(), ordenados.end());
+        std::vector<std::string> consultas = generarConsultas(ordenados, gen, [](const std::string& x) { return x + "~"; });
+
+        long long e1, e2, e3, e4, e5, e6, e7;
+        double t1, t2, t3, t4, t5, t6, t7;
+        {
+            BusquedaEstandar<std::string> estandar(ordenados);
+            t1 = medir(estandar, consultas, e1);
+        }
+        {
+            BusquedaSinSaltos<std::string> sinSaltos(ordenados);
+            t2 = medir(sinSaltos, consultas, e2);
+        }
+        {
+            BusquedaEytzinger<std::string> eytzinger(ordenados);
+            t3 = medir(eytzinger, consultas, e3);
+        }
+        {
+            BusquedaArbolB<std::string> arbolB(ordenados, std::string(4, '\xff')); // 0xFF no aparece en UTF-8
+            t4 = medir(arbolB, consultas, e4);
+        }
+        {
+            BusquedaNodos nodos(ordenados);
+            t7 = medir(nodos, consultas, e7);
+        }
+        {
+            BusquedaIndiceArbol indice(ordenados);
+            t5 = medir(indice, consultas, e5);
+        }
+        {
+            BusquedaBuscarHijo buscarHijo(ordenados);
+            t6 = medir(buscarHijo, consultas, e6);
+        }
+
+        std::cout << std::left << std::setw(10) << n << std::fixed << std::setprecision(1)
+                  << std::setw(11) << t1 << std::setw(12) << t2 << std::setw(11) << t3 << std::setw(10) << t4
+                  << std::setw(11) << t7 << std::setw(15) << t5 << std::setw(13) << t6
+                  << std::setw(10) << (e1 == e2 && e1 == e3 && e1 == e4 && e1 == e5 && e1 == e6 && e1 == e7 ? "sí" : "NO")
+                  << std::endl;
+        if (n == todos.size()) break;
+    }
+    std::cout << "buscarHijo usa el índice desde " << UMBRAL_INDICE_HIJOS << " hijos." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string rutaDirectorio = argc > 1 ? argv[1] : "";
+    compararEnteros();
+    compararNombres(rutaDirectorio);
+    return 0;
+}
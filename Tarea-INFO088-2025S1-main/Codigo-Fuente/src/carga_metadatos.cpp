@@ -0,0 +1,447 @@
+#include "tree.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+const unsigned MASCARA_STATX = STATX_TYPE | STATX_SIZE;
+const size_t TAMANO_BUFFER_DIRECTORIO = 64 * 1024;
+
+// Convierte el d_type de getdents64 al tipo de nodo
+TipoNodo tipoDesdeDirent(unsigned char dtype) {
+    switch (dtype) {
+        case DT_REG: return TipoNodo::Archivo;
+        case DT_DIR: return TipoNodo::Directorio;
+        case DT_LNK: return TipoNodo::Enlace;
+        case DT_UNKNOWN: return TipoNodo::Desconocido;
+        default: return TipoNodo::Otro;
+    }
+}
+
+// Convierte el campo st_mode/stx_mode al tipo de nodo
+TipoNodo tipoDesdeModo(unsigned modo) {
+    if (S_ISREG(modo)) return TipoNodo::Archivo;
+    if (S_ISDIR(modo)) return TipoNodo::Directorio;
+    if (S_ISLNK(modo)) return TipoNodo::Enlace;
+    return TipoNodo::Otro;
+}
+
+// Envoltorio mínimo sobre las syscalls de io_uring (sin depender de liburing)
+class AnilloIoUring {
+private:
+    int fd;
+    unsigned* sqCabeza;
+    unsigned* sqCola;
+    unsigned* sqMascara;
+    unsigned* sqArreglo;
+    unsigned* cqCabeza;
+    unsigned* cqCola;
+    unsigned* cqMascara;
+    io_uring_sqe* sqes;
+    io_uring_cqe* cqes;
+    void* sqMapa;
+    void* cqMapa;
+    size_t sqTamano;
+    size_t cqTamano;
+    size_t sqesTamano;
+    unsigned colaLocal;     // Cola de SQ aún no publicada al kernel
+    unsigned sinEnviar;     // SQEs preparadas y no enviadas
+
+public:
+    unsigned entradas;
+
+    explicit AnilloIoUring(unsigned numEntradas)
+        : fd(-1), sqCabeza(nullptr), sqCola(nullptr), sqMascara(nullptr), sqArreglo(nullptr),
+          cqCabeza(nullptr), cqCola(nullptr), cqMascara(nullptr), sqes(nullptr), cqes(nullptr),
+          sqMapa(MAP_FAILED), cqMapa(MAP_FAILED), sqTamano(0), cqTamano(0), sqesTamano(0),
+          colaLocal(0), sinEnviar(0), entradas(0) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, numEntradas, &params));
+        if (fd < 0) return;
+
+        sqTamano = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqTamano = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool mapaUnico = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (mapaUnico) {
+            sqTamano = cqTamano = std::max(sqTamano, cqTamano);
+        }
+
+        sqMapa = mmap(nullptr, sqTamano, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMapa == MAP_FAILED) {
+            cerrar();
+            return;
+        }
+        cqMapa = mapaUnico ? sqMapa
+                           : mmap(nullptr, cqTamano, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqMapa == MAP_FAILED) {
+            cerrar();
+            return;
+        }
+
+        sqesTamano = params.sq_entries * sizeof(io_uring_sqe);
+        void* mapaSqes = mmap(nullptr, sqesTamano, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (mapaSqes == MAP_FAILED) {
+            cerrar();
+            return;
+        }
+        sqes = static_cast<io_uring_sqe*>(mapaSqes);
+
+        char* sq = static_cast<char*>(sqMapa);
+        sqCabeza = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqCola = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMascara = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArreglo = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cqMapa);
+        cqCabeza = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqCola = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMascara = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        colaLocal = *sqCola;
+        entradas = params.sq_entries;
+    }
+
+    ~AnilloIoUring() {
+        cerrar();
+    }
+
+    AnilloIoUring(const AnilloIoUring&) = delete;
+    AnilloIoUring& operator=(const AnilloIoUring&) = delete;
+
+    bool valido() const {
+        return entradas > 0;
+    }
+
+    void cerrar() {
+        if (sqes) munmap(sqes, sqesTamano);
+        if (cqMapa != MAP_FAILED && cqMapa != sqMapa) munmap(cqMapa, cqTamano);
+        if (sqMapa != MAP_FAILED) munmap(sqMapa, sqTamano);
+        if (fd >= 0) close(fd);
+        sqes = nullptr;
+        sqMapa = cqMapa = MAP_FAILED;
+        fd = -1;
+        entradas = 0;
+    }
+
+    // Prepara un statx asíncrono; ruta y buffer deben seguir vivos hasta su completado
+    void prepararStatx(const char* ruta, struct statx* buffer, std::uint64_t datoUsuario) {
+        unsigned indice = colaLocal & *sqMascara;
+        io_uring_sqe* sqe = &sqes[indice];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_STATX;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<std::uint64_t>(ruta);
+        sqe->len = MASCARA_STATX;
+        sqe->off = reinterpret_cast<std::uint64_t>(buffer);
+        sqe->statx_flags = AT_SYMLINK_NOFOLLOW;
+        sqe->user_data = datoUsuario;
+        sqArreglo[indice] = indice;
+        ++colaLocal;
+        ++sinEnviar;
+    }
+
+    // Publica las SQEs pendientes y espera al menos minCompletados; retorna false si falla la syscall
+    bool enviar(unsigned minCompletados, long long& llamadasSistema) {
+        if (sinEnviar == 0 && minCompletados == 0) return true;
+
+        std::atomic_ref<unsigned>(*sqCola).store(colaLocal, std::memory_order_release);
+        unsigned banderas = minCompletados > 0 ? IORING_ENTER_GETEVENTS : 0;
+        long resultado;
+        do {
+            resultado = syscall(__NR_io_uring_enter, fd, sinEnviar, minCompletados, banderas, nullptr, 0);
+            ++llamadasSistema;
+        } while (resultado < 0 && errno == EINTR);
+
+        if (resultado < 0) return false;
+        sinEnviar -= std::min(sinEnviar, static_cast<unsigned>(resultado));
+        return true;
+    }
+
+    // Consume todos los completados disponibles llamando a procesar(user_data, res)
+    template <typename Funcion>
+    unsigned cosechar(Funcion procesar) {
+        unsigned cabeza = *cqCabeza;
+        unsigned cola = std::atomic_ref<unsigned>(*cqCola).load(std::memory_order_acquire);
+        unsigned procesados = 0;
+
+        while (cabeza != cola) {
+            const io_uring_cqe& cqe = cqes[cabeza & *cqMascara];
+            procesar(cqe.user_data, cqe.res);
+            ++cabeza;
+            ++procesados;
+        }
+
+        std::atomic_ref<unsigned>(*cqCabeza).store(cabeza, std::memory_order_release);
+        return procesados;
+    }
+};
+
+// Solicitud statx en vuelo; la ruta debe permanecer estable mientras el kernel la usa
+struct StatxPendiente {
+    NodoArbol* nodo;
+    std::string ruta;
+    struct statx buffer;
+    bool explorar; // El tipo no vino en d_type: decidir con statx si es directorio
+};
+
+struct DirectorioPendiente {
+    NodoArbol* nodo;
+    std::string ruta;
+};
+
+// Cargador BFS: getdents64 por directorio y statx por entrada (síncrono o en lotes io_uring)
+class CargadorMetadatos {
+private:
+    std::deque<DirectorioPendiente> directorios;
+    std::vector<StatxPendiente> ranuras;
+    std::vector<unsigned> ranurasLibres;
+    AnilloIoUring* anillo;
+    EstadisticasCarga& estadisticas;
+    std::vector<char> bufferDirectorio;
+
+    void aplicarStatx(StatxPendiente& pendiente) {
+        pendiente.nodo->tamano = pendiente.buffer.stx_size;
+        pendiente.nodo->tipo = tipoDesdeModo(pendiente.buffer.stx_mode);
+        if (pendiente.explorar && pendiente.nodo->tipo == TipoNodo::Directorio) {
+            directorios.push_back({pendiente.nodo, pendiente.ruta});
+        }
+    }
+
+    // Ejecuta un statx bloqueante y aplica su resultado
+    void statxSincrono(StatxPendiente& pendiente) {
+        estadisticas.llamadasSistema++;
+        if (statx(AT_FDCWD, pendiente.ruta.c_str(), AT_SYMLINK_NOFOLLOW, MASCARA_STATX, &pendiente.buffer) == 0) {
+            aplicarStatx(pendiente);
+        }
+    }
+
+    // Abandona io_uring tras un error de io_uring_enter: los statx preparados o en vuelo se repiten
+    // en forma síncrona (sobre una copia, por si el kernel aún escribe en el buffer de la ranura)
+    // y el resto de la carga sigue por el camino síncrono
+    void pasarASincrono() {
+        std::cerr << "Error en io_uring_enter: " << std::strerror(errno) << ", continuando con carga síncrona" << std::endl;
+        std::vector<bool> libre(ranuras.size(), false);
+        for (unsigned indice : ranurasLibres) {
+            libre[indice] = true;
+        }
+        anillo = nullptr;
+        estadisticas.modo = ModoCarga::Sincrono;
+        for (size_t i = 0; i < ranuras.size(); ++i) {
+            if (!libre[i]) {
+                StatxPendiente copia{ranuras[i].nodo, ranuras[i].ruta, {}, ranuras[i].explorar};
+                statxSincrono(copia);
+            }
+        }
+    }
+
+    // Envía el lote pendiente, bloquea hasta un completado y lo procesa
+    void esperarCompletados() {
+        if (!anillo->enviar(1, estadisticas.llamadasSistema)) {
+            pasarASincrono();
+            return;
+        }
+        cosecharCompletados();
+    }
+
+    void cosecharCompletados() {
+        anillo->cosechar([this](std::uint64_t ranura, int resultado) {
+            StatxPendiente& pendiente = ranuras[ranura];
+            if (resultado == 0) {
+                aplicarStatx(pendiente);
+            }
+            ranurasLibres.push_back(static_cast<unsigned>(ranura));
+        });
+    }
+
+    // Emite (o ejecuta en el modo síncrono) el statx de una entrada
+    void solicitarStatx(NodoArbol* nodo, std::string ruta, bool explorar) {
+        estadisticas.statsPedidos++;
+
+        // Cola llena: enviar el lote y esperar al menos un completado
+        while (anillo && ranurasLibres.empty()) {
+            esperarCompletados();
+        }
+
+        if (!anillo) {
+            StatxPendiente pendiente{nodo, std::move(ruta), {}, explorar};
+            statxSincrono(pendiente);
+            return;
+        }
+
+        unsigned indice = ranurasLibres.back();
+        ranurasLibres.pop_back();
+        StatxPendiente& pendiente = ranuras[indice];
+        pendiente.nodo = nodo;
+        pendiente.ruta = std::move(ruta);
+        pendiente.explorar = explorar;
+        anillo->prepararStatx(pendiente.ruta.c_str(), &pendiente.buffer, indice);
+    }
+
+    // Lee un directorio completo con getdents64 y cuelga sus hijos ya ordenados
+    void leerDirectorio(const DirectorioPendiente& directorio) {
+        estadisticas.llamadasSistema++;
+        int fd = open(directorio.ruta.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "Error al abrir el directorio " << directorio.ruta << ": " << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        std::vector<std::pair<NodoArbol*, unsigned char>> entradas;
+        ssize_t leidos;
+        while (true) {
+            estadisticas.llamadasSistema++;
+            leidos = getdents64(fd, bufferDirectorio.data(), bufferDirectorio.size());
+            if (leidos <= 0) break;
+
+            for (ssize_t pos = 0; pos < leidos;) {
+                const dirent64* entrada = reinterpret_cast<const dirent64*>(bufferDirectorio.data() + pos);
+                pos += entrada->d_reclen;
+
+                const char* nombre = entrada->d_name;
+                if (std::strcmp(nombre, ".") == 0 || std::strcmp(nombre, "..") == 0) continue;
+
+                NodoArbol* nodo = new NodoArbol(nombre);
+                nodo->tipo = tipoDesdeDirent(entrada->d_type);
+                entradas.push_back({nodo, entrada->d_type});
+            }
+        }
+        if (leidos < 0) {
+            std::cerr << "Error al leer el directorio " << directorio.ruta << ": " << std::strerror(errno) << std::endl;
+        }
+        estadisticas.llamadasSistema++;
+        close(fd);
+
+        // Los hijos llegan desordenados: ordenar una vez en vez de insertar ordenado uno a uno
+        std::sort(entradas.begin(), entradas.end(), [](const auto& a, const auto& b) {
+            return a.first->nombre < b.first->nombre;
+        });
+        NodoArbol* padre = directorio.nodo;
+        padre->hijos.reserve(padre->hijos.size() + entradas.size());
+        for (const auto& [nodo, dtype] : entradas) {
+            padre->hijos.push_back(nodo);
+        }
+        estadisticas.entradas += static_cast<long long>(entradas.size());
+
+        for (const auto& [nodo, dtype] : entradas) {
+            std::string ruta = directorio.ruta + "/" + nodo->nombre;
+            if (dtype == DT_DIR) {
+                directorios.push_back({nodo, ruta});
+            }
+            solicitarStatx(nodo, std::move(ruta), dtype == DT_UNKNOWN);
+        }
+    }
+
+public:
+    CargadorMetadatos(AnilloIoUring* anilloIoUring, EstadisticasCarga& estadisticasCarga)
+        : anillo(anilloIoUring), estadisticas(estadisticasCarga), bufferDirectorio(TAMANO_BUFFER_DIRECTORIO) {
+        if (anillo) {
+            ranuras.resize(anillo->entradas);
+            for (unsigned i = anillo->entradas; i > 0; --i) {
+                ranurasLibres.push_back(i - 1);
+            }
+        }
+    }
+
+    void cargar(NodoArbol* raiz, const std::string& rutaBase) {
+        directorios.push_back({raiz, rutaBase});
+
+        while (!directorios.empty() || (anillo && ranurasLibres.size() < ranuras.size())) {
+            if (directorios.empty()) {
+                // Solo quedan statx en vuelo (p. ej. d_type desconocido que puede ser directorio)
+                esperarCompletados();
+                continue;
+            }
+
+            DirectorioPendiente directorio = std::move(directorios.front());
+            directorios.pop_front();
+            leerDirectorio(directorio);
+
+            // Mantener el pipeline lleno sin bloquear: enviar lo preparado y recoger lo ya terminado
+            if (anillo) {
+                if (anillo->enviar(0, estadisticas.llamadasSistema)) {
+                    cosecharCompletados();
+                } else {
+                    pasarASincrono();
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+// Función para cargar el árbol junto con tamaño y tipo de cada entrada
+EstadisticasCarga ArbolSistemaArchivos::cargarDatosConMetadatos(const std::string& rutaBase, ModoCarga modo,
+                                                                unsigned profundidadCola) {
+    if (raiz) {
+        delete raiz;
+    }
+    compartido = false;
+    invalidarManejadores();
+
+    raiz = new NodoArbol("raiz");
+    raiz->tipo = TipoNodo::Directorio;
+
+    EstadisticasCarga estadisticas;
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    if (modo == ModoCarga::Iterador) {
+        estadisticas.modo = ModoCarga::Iterador;
+        try {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(rutaBase)) {
+                std::string rutaRelativa = std::filesystem::relative(entry.path(), rutaBase).string();
+                NodoArbol* nodo = insertarRuta(rutaRelativa);
+
+                struct stat info;
+                estadisticas.statsPedidos++;
+                estadisticas.llamadasSistema++;
+                if (lstat(entry.path().c_str(), &info) == 0) {
+                    nodo->tamano = static_cast<std::uint64_t>(info.st_size);
+                    nodo->tipo = tipoDesdeModo(info.st_mode);
+                }
+                estadisticas.entradas++;
+            }
+        } catch (const std::filesystem::filesystem_error& e) {
+            std::cerr << "Error al acceder al sistema de archivos: " << e.what() << std::endl;
+        }
+    } else {
+        // Solo el modo io_uring paga la preparación del anillo (io_uring_setup y los mmap)
+        std::unique_ptr<AnilloIoUring> anillo;
+        if (modo == ModoCarga::IoUring) {
+            anillo = std::make_unique<AnilloIoUring>(std::max(1u, profundidadCola));
+            if (!anillo->valido()) {
+                std::cerr << "io_uring no disponible, usando carga síncrona" << std::endl;
+                anillo.reset();
+            }
+        }
+
+        estadisticas.modo = anillo ? ModoCarga::IoUring : ModoCarga::Sincrono;
+        CargadorMetadatos cargador(anillo.get(), estadisticas);
+        cargador.cargar(raiz, rutaBase);
+    }
+
+    auto fin = std::chrono::high_resolution_clock::now();
+    auto duracion = std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio);
+    estadisticas.tiempoMs = static_cast<double>(duracion.count()) / 1000.0;
+
+    if (filtro) {
+        reconstruirFiltro();
+    }
+    return estadisticas;
+}
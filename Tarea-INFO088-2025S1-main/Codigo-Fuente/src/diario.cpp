@@ -0,0 +1,447 @@
+#include "diario.h"
+#include "tree.h"
+#include <cerrno>
+#include <cstdio>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const char OPERACION_INSERCION = 'I';
+const char OPERACION_ELIMINACION = 'E';
+const char MAGIA_INSTANTANEA[8] = {'A', 'R', 'B', 'O', 'L', 'P', 'C', '2'};
+
+// Un nodo serializado ocupa al menos 4 bytes (largo, tipo, tamaño y número de hijos)
+const std::uint64_t BYTES_MINIMOS_NODO = 4;
+
+// Suma FNV-1a de 32 bits para detectar registros truncados o corruptos
+std::uint32_t sumaVerificacion(char operacion, const char* datos, size_t largo) {
+    std::uint32_t hash = 2166136261u;
+    hash = (hash ^ static_cast<unsigned char>(operacion)) * 16777619u;
+    for (size_t i = 0; i < largo; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(datos[i])) * 16777619u;
+    }
+    return hash;
+}
+
+// Suma FNV-1a de 64 bits del cuerpo de una instantánea
+std::uint64_t sumaInstantanea(const char* datos, size_t largo) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < largo; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(datos[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void escribirVarint(std::string& salida, std::uint64_t valor) {
+    while (valor >= 0x80) {
+        salida.push_back(static_cast<char>((valor & 0x7F) | 0x80));
+        valor >>= 7;
+    }
+    salida.push_back(static_cast<char>(valor));
+}
+
+// Lee un varint desde [pos, fin); retorna false si está truncado
+bool leerVarint(const char*& pos, const char* fin, std::uint64_t& valor) {
+    valor = 0;
+    for (int desplazamiento = 0; pos < fin && desplazamiento < 64; desplazamiento += 7) {
+        unsigned char byte = static_cast<unsigned char>(*pos++);
+        valor |= static_cast<std::uint64_t>(byte & 0x7F) << desplazamiento;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+void escribirVarint(std::ostream& salida, std::uint64_t valor) {
+    std::string bytes;
+    escribirVarint(bytes, valor);
+    salida.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Escribe todo el buffer reintentando escrituras parciales
+bool escribirTodo(int fd, const char* datos, size_t largo) {
+    while (largo > 0) {
+        ssize_t escritos = write(fd, datos, largo);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        datos += escritos;
+        largo -= static_cast<size_t>(escritos);
+    }
+    return true;
+}
+
+// Sincroniza el directorio que contiene 'ruta', para que un rename dentro de él sea durable
+bool sincronizarDirectorio(const std::string& ruta) {
+    std::string directorio = std::filesystem::path(ruta).parent_path().string();
+    int fdDirectorio = open(directorio.empty() ? "." : directorio.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fdDirectorio < 0) return false;
+    bool exito = fsync(fdDirectorio) == 0;
+    close(fdDirectorio);
+    return exito;
+}
+
+// Preorden: nombre, tipo, tamaño, número de hijos y luego cada hijo (ya ordenados)
+void escribirNodo(std::ostream& salida, const NodoArbol* nodo) {
+    escribirVarint(salida, nodo->nombre.size());
+    salida.write(nodo->nombre.data(), static_cast<std::streamsize>(nodo->nombre.size()));
+    salida.put(static_cast<char>(nodo->tipo));
+    escribirVarint(salida, nodo->tamano);
+    escribirVarint(salida, nodo->hijos.size());
+    for (const NodoArbol* hijo : nodo->hijos) {
+        escribirNodo(salida, hijo);
+    }
+}
+
+// Lee un nodo desde [pos, fin); retorna nullptr si los datos están truncados o fuera de rango
+NodoArbol* leerNodo(const char*& pos, const char* fin) {
+    std::uint64_t largo, tamano, numHijos;
+    if (!leerVarint(pos, fin, largo) || largo > NAME_MAX || static_cast<std::uint64_t>(fin - pos) < largo + 1) {
+        return nullptr;
+    }
+
+    std::string nombre(pos, largo);
+    pos += largo;
+    unsigned char tipo = static_cast<unsigned char>(*pos++);
+    if (tipo > static_cast<unsigned char>(TipoNodo::Otro) || !leerVarint(pos, fin, tamano) ||
+        !leerVarint(pos, fin, numHijos) || numHijos > static_cast<std::uint64_t>(fin - pos) / BYTES_MINIMOS_NODO) {
+        return nullptr;
+    }
+
+    NodoArbol* nodo = new NodoArbol(nombre);
+    nodo->tipo = static_cast<TipoNodo>(tipo);
+    nodo->tamano = tamano;
+    nodo->hijos.reserve(numHijos);
+    for (std::uint64_t i = 0; i < numHijos; ++i) {
+        NodoArbol* hijo = leerNodo(pos, fin);
+        if (!hijo) {
+            delete nodo;
+            return nullptr;
+        }
+        nodo->hijos.push_back(hijo);
+    }
+    return nodo;
+}
+
+// Lee un registro completo desde [pos, fin); retorna false si está truncado, su suma no coincide
+// o la operación es desconocida (pos queda entonces en un punto indeterminado)
+bool leerRegistro(const char*& pos, const char* fin, char& operacion, const char*& ruta, std::uint64_t& largo) {
+    if (pos >= fin) return false;
+    operacion = *pos++;
+    if (!leerVarint(pos, fin, largo) || static_cast<std::uint64_t>(fin - pos) < largo + 4) return false;
+
+    ruta = pos;
+    pos += largo;
+    std::uint32_t suma = 0;
+    for (int i = 0; i < 4; ++i) {
+        suma |= static_cast<std::uint32_t>(static_cast<unsigned char>(*pos++)) << (8 * i);
+    }
+    return suma == sumaVerificacion(operacion, ruta, largo) &&
+           (operacion == OPERACION_INSERCION || operacion == OPERACION_ELIMINACION);
+}
+
+// Largo del prefijo de registros válidos del diario (lo que reproducirDiario aplicaría)
+off_t largoValidoDiario(const std::string& contenido) {
+    const char* inicio = contenido.data();
+    const char* pos = inicio;
+    const char* fin = inicio + contenido.size();
+    const char* finValido = inicio;
+    char operacion;
+    const char* ruta;
+    std::uint64_t largo;
+    while (leerRegistro(pos, fin, operacion, ruta, largo)) {
+        finValido = pos;
+    }
+    return static_cast<off_t>(finValido - inicio);
+}
+
+} // namespace
+
+// Constructor: abre (o crea) el diario en modo anexar. Si una caída dejó un registro a medias al
+// final, se recorta el archivo al último registro válido; si no, los nuevos quedarían detrás de
+// él y la reproducción nunca los alcanzaría
+DiarioMutaciones::DiarioMutaciones(const ConfiguracionDiario& configuracionDiario)
+    : configuracion(configuracionDiario), fd(-1), pendientes(0), registrosDesdePuntoControl(0),
+      registrosTotales(0), sincronizaciones(0), bytesConfirmados(0), errorEscritura(false) {
+    fd = open(configuracion.rutaDiario.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error al abrir el diario " << configuracion.rutaDiario << ": " << std::strerror(errno) << std::endl;
+    } else {
+        bytesConfirmados = lseek(fd, 0, SEEK_END);
+        if (bytesConfirmados > 0) {
+            std::ifstream entrada(configuracion.rutaDiario, std::ios::binary);
+            std::string contenido((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+            off_t valido = largoValidoDiario(contenido);
+            if (valido < bytesConfirmados) {
+                std::cerr << "Diario con cola corrupta: se descartan " << (bytesConfirmados - valido)
+                          << " bytes de " << configuracion.rutaDiario << std::endl;
+                if (ftruncate(fd, valido) != 0) {
+                    std::cerr << "Error al recortar el diario: " << std::strerror(errno) << std::endl;
+                    errorEscritura = true;
+                }
+                bytesConfirmados = valido;
+            }
+        }
+    }
+    if (configuracion.tamanoGrupo < 1) {
+        configuracion.tamanoGrupo = 1;
+    }
+}
+
+// Destructor: vuelca el último grupo antes de cerrar
+DiarioMutaciones::~DiarioMutaciones() {
+    confirmar();
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool DiarioMutaciones::abierto() const {
+    return fd >= 0;
+}
+
+// Función para saber si cada mutación confirmada al llamador ya está en disco
+bool DiarioMutaciones::durable() const {
+    return configuracion.sincronizar && configuracion.tamanoGrupo == 1;
+}
+
+// Función para saber si el diario dejó de aceptar registros por un error de escritura
+bool DiarioMutaciones::tieneError() const {
+    return fd < 0 || errorEscritura;
+}
+
+// Función para codificar un registro en el buffer del grupo actual; retorna false si el
+// registro no pudo anexarse o si el volcado del grupo falló
+bool DiarioMutaciones::anexar(char operacion, const std::string& ruta) {
+    if (tieneError()) return false;
+
+    buffer.push_back(operacion);
+    escribirVarint(buffer, ruta.size());
+    buffer.append(ruta);
+
+    std::uint32_t suma = sumaVerificacion(operacion, ruta.data(), ruta.size());
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<char>((suma >> (8 * i)) & 0xFF));
+    }
+
+    registrosTotales++;
+    registrosDesdePuntoControl++;
+    if (++pendientes >= configuracion.tamanoGrupo) {
+        return confirmar();
+    }
+    return true;
+}
+
+bool DiarioMutaciones::registrarInsercion(const std::string& ruta) {
+    return anexar(OPERACION_INSERCION, ruta);
+}
+
+bool DiarioMutaciones::registrarEliminacion(const std::string& ruta) {
+    return anexar(OPERACION_ELIMINACION, ruta);
+}
+
+// Función para confirmar el grupo pendiente: un write y un fdatasync para todos sus registros.
+// Si alguno falla se recorta el archivo al último grupo completo (un registro a medias ocultaría
+// a todos los siguientes al reproducir) y el diario deja de aceptar registros
+bool DiarioMutaciones::confirmar() {
+    if (tieneError()) return false;
+    if (buffer.empty()) return true;
+
+    bool escrito = escribirTodo(fd, buffer.data(), buffer.size());
+    if (escrito && (!configuracion.sincronizar || fdatasync(fd) == 0)) {
+        bytesConfirmados += static_cast<off_t>(buffer.size());
+        if (configuracion.sincronizar) {
+            sincronizaciones++;
+        }
+        buffer.clear();
+        pendientes = 0;
+        return true;
+    }
+
+    std::cerr << "Error al " << (escrito ? "sincronizar" : "escribir") << " el diario: " << std::strerror(errno)
+              << "; se descartan " << pendientes << " registros y el diario queda detenido" << std::endl;
+    if (ftruncate(fd, bytesConfirmados) != 0) {
+        std::cerr << "Error al recortar el diario: " << std::strerror(errno) << std::endl;
+    }
+    errorEscritura = true;
+    buffer.clear();
+    pendientes = 0;
+    return false;
+}
+
+bool DiarioMutaciones::puntoControlPendiente() const {
+    return configuracion.registrosPorPuntoControl > 0 &&
+           registrosDesdePuntoControl >= configuracion.registrosPorPuntoControl;
+}
+
+// Función para tomar un punto de control: instantánea atómica (tmp + rename) y truncado del diario.
+// El rename se hace durable (fsync del directorio) antes de truncar: si no, tras una caída podría
+// quedar el diario vacío junto al punto de control anterior
+bool DiarioMutaciones::guardarPuntoControl(const ArbolSistemaArchivos& arbol) {
+    if (!confirmar()) return false;
+
+    std::string rutaTemporal = configuracion.rutaPuntoControl + ".tmp";
+    {
+        std::ofstream salida(rutaTemporal, std::ios::binary | std::ios::trunc);
+        if (!salida.is_open()) {
+            std::cerr << "Error al crear el punto de control " << rutaTemporal << std::endl;
+            return false;
+        }
+        arbol.guardarInstantanea(salida);
+        if (!salida) return false;
+    }
+
+    if (configuracion.sincronizar) {
+        int fdTemporal = open(rutaTemporal.c_str(), O_RDONLY | O_CLOEXEC);
+        bool sincronizado = fdTemporal >= 0 && fdatasync(fdTemporal) == 0;
+        if (fdTemporal >= 0) {
+            close(fdTemporal);
+        }
+        if (!sincronizado) {
+            std::cerr << "Error al sincronizar el punto de control: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        sincronizaciones++;
+    }
+
+    if (std::rename(rutaTemporal.c_str(), configuracion.rutaPuntoControl.c_str()) != 0) {
+        std::cerr << "Error al instalar el punto de control: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (configuracion.sincronizar) {
+        if (!sincronizarDirectorio(configuracion.rutaPuntoControl)) {
+            std::cerr << "Error al sincronizar el directorio del punto de control: " << std::strerror(errno) << std::endl;
+            return false; // El diario se conserva: sigue siendo válido sobre el punto de control anterior
+        }
+        sincronizaciones++;
+    }
+
+    // La instantánea ya cubre todo lo registrado: el diario puede empezar de cero. Si el
+    // truncado falla, reproducir el diario sobre la nueva instantánea aplicaría registros dos
+    // veces, así que el diario se detiene
+    if (fd >= 0) {
+        if (ftruncate(fd, 0) != 0 || (configuracion.sincronizar && fdatasync(fd) != 0)) {
+            std::cerr << "Error al truncar el diario: " << std::strerror(errno) << std::endl;
+            errorEscritura = true;
+            return false;
+        }
+        bytesConfirmados = 0;
+        if (configuracion.sincronizar) {
+            sincronizaciones++;
+        }
+    }
+    registrosDesdePuntoControl = 0;
+    return true;
+}
+
+long long DiarioMutaciones::obtenerRegistrosTotales() const {
+    return registrosTotales;
+}
+
+long long DiarioMutaciones::obtenerSincronizaciones() const {
+    return sincronizaciones;
+}
+
+// Función para guardar el árbol completo en formato binario: magia, cuerpo (indicador de raíz y
+// nodos en preorden) y suma FNV-1a de 64 bits del cuerpo en little-endian
+void ArbolSistemaArchivos::guardarInstantanea(std::ostream& salida) const {
+    std::ostringstream cuerpo;
+    cuerpo.put(raiz ? 1 : 0);
+    if (raiz) {
+        escribirNodo(cuerpo, raiz);
+    }
+    std::string datos = cuerpo.str();
+    std::uint64_t suma = sumaInstantanea(datos.data(), datos.size());
+
+    salida.write(MAGIA_INSTANTANEA, sizeof(MAGIA_INSTANTANEA));
+    salida.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+    for (int i = 0; i < 8; ++i) {
+        salida.put(static_cast<char>((suma >> (8 * i)) & 0xFF));
+    }
+}
+
+// Función para reemplazar el árbol por una instantánea; retorna false si está corrupta o truncada
+bool ArbolSistemaArchivos::cargarInstantanea(std::istream& entrada) {
+    std::string contenido((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+    if (contenido.size() < sizeof(MAGIA_INSTANTANEA) + 1 + 8 ||
+        std::memcmp(contenido.data(), MAGIA_INSTANTANEA, sizeof(MAGIA_INSTANTANEA)) != 0) {
+        return false;
+    }
+
+    const char* pos = contenido.data() + sizeof(MAGIA_INSTANTANEA);
+    const char* fin = contenido.data() + contenido.size() - 8;
+    std::uint64_t suma = 0;
+    for (int i = 0; i < 8; ++i) {
+        suma |= static_cast<std::uint64_t>(static_cast<unsigned char>(fin[i])) << (8 * i);
+    }
+    if (suma != sumaInstantanea(pos, static_cast<size_t>(fin - pos))) return false;
+
+    char tieneRaiz = *pos++;
+    NodoArbol* nuevaRaiz = nullptr;
+    if (tieneRaiz == 1) {
+        nuevaRaiz = leerNodo(pos, fin);
+        if (!nuevaRaiz) return false;
+    } else if (tieneRaiz != 0) {
+        return false;
+    }
+    if (pos != fin) {
+        delete nuevaRaiz;
+        return false;
+    }
+
+    delete raiz;
+    raiz = nuevaRaiz;
+    compartido = false;
+    invalidarManejadores();
+    if (filtro) {
+        reconstruirFiltro();
+    }
+    return true;
+}
+
+// Función para aplicar al árbol los registros válidos del diario; se detiene en la primera cola rota
+long long reproducirDiario(ArbolSistemaArchivos& arbol, const std::string& rutaDiario) {
+    std::ifstream entrada(rutaDiario, std::ios::binary);
+    if (!entrada.is_open()) return 0; // Sin diario: nada que reproducir
+
+    std::string contenido((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+    const char* pos = contenido.data();
+    const char* fin = pos + contenido.size();
+    long long aplicados = 0;
+
+    char operacion;
+    const char* ruta;
+    std::uint64_t largo;
+    while (leerRegistro(pos, fin, operacion, ruta, largo)) {
+        std::string rutaRegistro(ruta, largo);
+        if (operacion == OPERACION_INSERCION) {
+            arbol.insertar(rutaRegistro);
+        } else {
+            arbol.eliminar(rutaRegistro);
+        }
+        aplicados++;
+    }
+
+    return aplicados;
+}
+
+// Función de recuperación: punto de control + diario. Retorna registros reproducidos o -1 si
+// el punto de control existe pero está corrupto. El árbol no debe tener un diario adjunto.
+long long recuperarArbol(ArbolSistemaArchivos& arbol, const ConfiguracionDiario& configuracion) {
+    std::ifstream puntoControl(configuracion.rutaPuntoControl, std::ios::binary);
+    if (puntoControl.is_open()) {
+        if (!arbol.cargarInstantanea(puntoControl)) {
+            std::cerr << "Punto de control corrupto: " << configuracion.rutaPuntoControl << std::endl;
+            return -1;
+        }
+    }
+
+    return reproducirDiario(arbol, configuracion.rutaDiario);
+}
@@ -0,0 +1,140 @@
+#include "tree.h"
+#include "diario.h"
+#include <functional>
+#include <iostream>
+
+namespace {
+
+// Finalizador de splitmix64
+std::uint64_t mezclar(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Un nodo es directorio si así lo dicen sus metadatos o si tiene hijos (como en buscar)
+bool esDirectorio(const NodoArbol* nodo) {
+    return nodo->tipo == TipoNodo::Directorio || !nodo->hijos.empty();
+}
+
+// Recorre a la par dos nodos del mismo nombre y tipo, mezclando sus hijos ordenados.
+// 'ruta' se extiende y se recorta en el lugar para no construir rutas de lo que no cambió.
+void diferenciaNodos(const NodoArbol* a, const NodoArbol* b, std::string& ruta, const ReceptorCambios& receptor) {
+    if (a == b || ArbolSistemaArchivos::hashSubarbol(a) == ArbolSistemaArchivos::hashSubarbol(b)) {
+        return; // Subárboles idénticos
+    }
+
+    size_t largoBase = ruta.size();
+    auto extender = [&](const std::string& nombre) {
+        if (largoBase > 0) ruta += '/';
+        ruta += nombre;
+    };
+
+    size_t i = 0, j = 0;
+    while (i < a->hijos.size() || j < b->hijos.size()) {
+        const NodoArbol* hijoA = i < a->hijos.size() ? a->hijos[i] : nullptr;
+        const NodoArbol* hijoB = j < b->hijos.size() ? b->hijos[j] : nullptr;
+
+        if (hijoA && (!hijoB || hijoA->nombre < hijoB->nombre)) {
+            extender(hijoA->nombre);
+            receptor(TipoCambio::Eliminado, ruta, nullptr);
+            ++i;
+        } else if (hijoB && (!hijoA || hijoB->nombre < hijoA->nombre)) {
+            extender(hijoB->nombre);
+            receptor(TipoCambio::Agregado, ruta, hijoB);
+            ++j;
+        } else {
+            extender(hijoA->nombre);
+            if (esDirectorio(hijoA) != esDirectorio(hijoB)) {
+                receptor(TipoCambio::CambioTipo, ruta, hijoB);
+            } else {
+                diferenciaNodos(hijoA, hijoB, ruta, receptor);
+            }
+            ++i;
+            ++j;
+        }
+        ruta.resize(largoBase);
+    }
+}
+
+} // namespace
+
+// Función para obtener el hash de un subárbol (nombres, estructura y archivo/directorio).
+// Se calcula perezosamente y queda en caché hasta que una mutación invalide su camino.
+std::uint64_t ArbolSistemaArchivos::hashSubarbol(const NodoArbol* nodo) {
+    if (nodo->hashSubarbol != 0) {
+        return nodo->hashSubarbol;
+    }
+
+    std::uint64_t hash = mezclar(std::hash<std::string>{}(nodo->nombre) + (esDirectorio(nodo) ? 1 : 0));
+    for (const NodoArbol* hijo : nodo->hijos) {
+        hash = mezclar(hash ^ (hashSubarbol(hijo) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+    }
+
+    nodo->hashSubarbol = hash != 0 ? hash : 1;
+    return nodo->hashSubarbol;
+}
+
+// Función para obtener (y dejar en caché) el hash de todo el árbol
+std::uint64_t ArbolSistemaArchivos::hashArbol() const {
+    return raiz ? hashSubarbol(raiz) : 0;
+}
+
+// Función para emitir las diferencias de 'a' a 'b' como flujo de cambios.
+// Un subárbol agregado o eliminado se informa una sola vez, por su raíz.
+void diferencia(const ArbolSistemaArchivos& a, const ArbolSistemaArchivos& b, const ReceptorCambios& receptor) {
+    NodoArbol vacio("raiz");
+    std::string ruta;
+    diferenciaNodos(a.raiz ? a.raiz : &vacio, b.raiz ? b.raiz : &vacio, ruta, receptor);
+}
+
+// Función para aplicar sobre 'destino' el delta que lleva de 'base' a 'nuevo'.
+// Retorna el número de cambios aplicados, o -1 si 'destino' es el mismo árbol que 'nuevo'
+// (los cambios apuntan a nodos de 'nuevo' que eliminar() liberaría antes de copiarlos).
+// Si destino tiene diario, en vez de registrar cada nodo copiado se toma un punto de control al terminar;
+// si ese punto de control falla también retorna -1, pero el árbol en memoria ya quedó fusionado
+// y solo el estado en disco (punto de control + diario anteriores) sigue sin los cambios.
+long long fusionar(ArbolSistemaArchivos& destino, const ArbolSistemaArchivos& base, const ArbolSistemaArchivos& nuevo) {
+    if (&destino == &nuevo) {
+        std::cerr << "fusionar: el destino no puede ser el mismo árbol que 'nuevo'" << std::endl;
+        return -1;
+    }
+    if (destino.diario && destino.diario->tieneError()) {
+        std::cerr << "fusionar: el diario del destino está detenido; el árbol no cambia" << std::endl;
+        return -1;
+    }
+
+    // Reunir primero los cambios: destino puede ser el mismo árbol que base
+    std::vector<std::pair<std::string, const NodoArbol*>> cambios;
+    diferencia(base, nuevo, [&cambios](TipoCambio tipo, const std::string& ruta, const NodoArbol* nodo) {
+        cambios.push_back({ruta, tipo == TipoCambio::Eliminado ? nullptr : nodo});
+    });
+
+    DiarioMutaciones* diario = destino.diario;
+    destino.diario = nullptr;
+
+    for (const auto& [ruta, nodoNuevo] : cambios) {
+        destino.eliminar(ruta);
+        if (!nodoNuevo) continue;
+
+        size_t separador = ruta.rfind('/');
+        NodoArbol* padre = destino.insertarRuta(separador == std::string::npos ? "" : ruta.substr(0, separador));
+        NodoArbol* copia = ArbolSistemaArchivos::clonarSubarbol(nodoNuevo);
+        destino.insertarHijoOrdenado(padre, copia);
+        padre->hashSubarbol = 0;
+        if (destino.filtro) {
+            destino.registrarSubarbolEnFiltro(copia, ArbolSistemaArchivos::estadoHashRuta(ruta), true);
+        }
+    }
+
+    destino.diario = diario;
+    if (diario && !cambios.empty() && !diario->guardarPuntoControl(destino)) {
+        std::cerr << "fusionar: no se pudo guardar el punto de control; los cambios no son durables" << std::endl;
+        return -1;
+    }
+
+    return static_cast<long long>(cambios.size());
+}
@@ -1,15 +1,31 @@
 #include "experimentacion.h"
 #include "tree.h"
+#include "arbol_concurrente.h"
+#include "arbol_paginado.h"
+#include "diario.h"
+#include "filtro_cuckoo.h"
+#include "visitante_paralelo.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <random>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <filesystem>
+#include <iterator>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
 
 // Constantes para los experimentos
 const int REP = 100000; // 100,000 repeticiones
 const int NUM_DIRECTORIOS_INSERCION = 2000; // Para experimentos de inserción
+const int NUM_MUTACIONES_DIARIO = 20000; // Mutaciones por configuración del diario
 
 // Nombres de archivos para inserción
 const std::vector<std::string> NOMBRES_ARCHIVOS = {
@@ -85,19 +101,35 @@ double medirTiempoCreacion(const std::string& rutaBase) {
     return static_cast<double>(duracion.count()) / 1000.0; // Convertir a milisegundos
 }
 
-// Función para medir el tiempo promedio de búsqueda
-double medirTiempoBusqueda(ArbolSistemaArchivos& arbol, const std::vector<std::string>& rutas) {
+// Función para medir el tiempo promedio de búsqueda; una fracción 'proporcionFallos' de las
+// consultas pide rutas inexistentes (la ruta original con el último componente alterado)
+double medirTiempoBusqueda(ArbolSistemaArchivos& arbol, const std::vector<std::string>& rutas,
+                           double proporcionFallos) {
     if (rutas.empty()) return 0.0;
     
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist(0, rutas.size() - 1);
+    std::uniform_real_distribution<> moneda(0.0, 1.0);
     
-    auto inicio = std::chrono::high_resolution_clock::now();
-    
+    // Consultas armadas antes de medir para no contar la construcción de las rutas alteradas
+    std::vector<const std::string*> consultas(REP);
+    std::vector<std::string> fallos;
+    fallos.reserve(static_cast<size_t>(static_cast<double>(REP) * proporcionFallos * 1.1) + 1);
     for (int i = 0; i < REP; ++i) {
         int idx = dist(gen);
-        arbol.buscar(rutas[idx]);
+        if (proporcionFallos > 0.0 && moneda(gen) < proporcionFallos && fallos.size() < fallos.capacity()) {
+            fallos.push_back(rutas[idx] + "~");
+            consultas[i] = &fallos.back();
+        } else {
+            consultas[i] = &rutas[idx];
+        }
+    }
+    
+    auto inicio = std::chrono::high_resolution_clock::now();
+    
+    for (const std::string* consulta : consultas) {
+        arbol.buscar(*consulta);
     }
     
     auto fin = std::chrono::high_resolution_clock::now();
@@ -155,6 +187,156 @@ double medirTiempoInsercion(ArbolSistemaArchivos& arbol, const std::vector<std::
     return static_cast<double>(duracion.count()) / REP; // Promedio en nanosegundos
 }
 
+namespace {
+
+// Reparte los directorios según su componente de primer nivel: cada hilo escribe en sus propios fragmentos
+std::vector<std::vector<std::string>> repartirPorFragmento(const std::vector<std::string>& directorios, int numHilos) {
+    std::vector<std::vector<std::string>> reparto(static_cast<size_t>(numHilos));
+    std::map<std::string, size_t> fragmentos;
+
+    for (const std::string& directorio : directorios) {
+        std::string primerNivel = directorio.substr(0, directorio.find('/'));
+        auto [it, nuevo] = fragmentos.emplace(primerNivel, fragmentos.size());
+        reparto[it->second % reparto.size()].push_back(directorio);
+    }
+
+    // Con más hilos que fragmentos, los hilos sobrantes escriben en todo el árbol
+    for (auto& propios : reparto) {
+        if (propios.empty()) propios = directorios;
+    }
+    return reparto;
+}
+
+// Lanza numHilos escritores sobre 'insertar' y retorna el throughput en inserciones por segundo.
+// Con probabilidad 'contencion' cada inserción va al directorio caliente compartido por todos.
+template <typename Insertar>
+double medirInsercionMultihilo(const std::vector<std::string>& directorios, int numHilos, double contencion,
+                               Insertar insertar) {
+    if (directorios.empty() || numHilos <= 0) return 0.0;
+
+    std::vector<std::vector<std::string>> reparto = repartirPorFragmento(directorios, numHilos);
+    const std::string& directorioCaliente = directorios.front();
+    const int operacionesPorHilo = REP / numHilos;
+
+    std::atomic<int> listos{0};
+    std::atomic<bool> partida{false};
+    std::vector<std::thread> hilos;
+
+    for (int h = 0; h < numHilos; ++h) {
+        hilos.emplace_back([&, h]() {
+            // Generar las rutas antes de la partida para medir solo la inserción
+            const std::vector<std::string>& propios = reparto[static_cast<size_t>(h)];
+            std::mt19937 gen(static_cast<unsigned>(h) + 1);
+            std::uniform_real_distribution<> moneda(0.0, 1.0);
+            std::uniform_int_distribution<size_t> distDir(0, propios.size() - 1);
+            std::uniform_int_distribution<size_t> distArchivo(0, NOMBRES_ARCHIVOS.size() - 1);
+
+            std::vector<std::string> rutas;
+            rutas.reserve(static_cast<size_t>(operacionesPorHilo));
+            for (int i = 0; i < operacionesPorHilo; ++i) {
+                const std::string& directorio = moneda(gen) < contencion ? directorioCaliente : propios[distDir(gen)];
+                rutas.push_back(directorio + "/" + NOMBRES_ARCHIVOS[distArchivo(gen)] + "_" +
+                                std::to_string(h) + "_" + std::to_string(i));
+            }
+
+            listos.fetch_add(1);
+            while (!partida.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (const std::string& ruta : rutas) {
+                insertar(ruta);
+            }
+        });
+    }
+
+    while (listos.load() < numHilos) {
+        std::this_thread::yield();
+    }
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    partida.store(true, std::memory_order_release);
+    for (std::thread& hilo : hilos) {
+        hilo.join();
+    }
+    auto fin = std::chrono::high_resolution_clock::now();
+
+    auto duracion = std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio);
+    double segundos = static_cast<double>(duracion.count()) / 1e9;
+    return segundos > 0.0 ? static_cast<double>(operacionesPorHilo * numHilos) / segundos : 0.0;
+}
+
+} // namespace
+
+// Función para medir el throughput de inserción multihilo sobre el árbol con bloqueo por subárbol
+double medirInsercionConcurrente(ArbolConcurrente& arbol, const std::vector<std::string>& directorios,
+                                 int numHilos, double contencion) {
+    return medirInsercionMultihilo(directorios, numHilos, contencion, [&arbol](const std::string& ruta) {
+        arbol.insertar(ruta);
+    });
+}
+
+// Función para medir el throughput de inserción multihilo serializando todo con un cerrojo global
+double medirInsercionCerrojoGlobal(ArbolSistemaArchivos& arbol, const std::vector<std::string>& directorios,
+                                   int numHilos, double contencion) {
+    std::mutex cerrojoGlobal;
+    return medirInsercionMultihilo(directorios, numHilos, contencion, [&](const std::string& ruta) {
+        std::lock_guard<std::mutex> guardia(cerrojoGlobal);
+        arbol.insertar(ruta);
+    });
+}
+
+// Función para comparar el escalado de la inserción multihilo según hilos y contención
+void ejecutarExperimentoConcurrente(const std::string& rutaDatos) {
+    ArbolSistemaArchivos base;
+    base.cargarDatos(rutaDatos);
+    std::vector<std::string> todasLasRutas = base.obtenerTodasLasRutas();
+    std::vector<std::string> todosLosDirectorios = base.obtenerTodosLosDirectorios();
+
+    if (todosLosDirectorios.empty()) {
+        std::cout << "El directorio no contiene subdirectorios donde insertar." << std::endl;
+        return;
+    }
+
+    const std::vector<int> numerosHilos = {1, 2, 4, 8, 16};
+    const std::vector<double> contenciones = {0.0, 0.1, 0.5, 1.0};
+
+    std::cout << "\n=== INSERCIÓN MULTIHILO (" << REP << " inserciones por medición) ===" << std::endl;
+    std::cout << "Núcleos disponibles: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << std::left << std::setw(8) << "Hilos"
+              << std::setw(13) << "Contención"
+              << std::setw(22) << "Por subárbol (op/s)"
+              << std::setw(22) << "Cerrojo global (op/s)"
+              << std::setw(12) << "Aceleración" << std::endl;
+    std::cout << std::string(77, '-') << std::endl;
+
+    for (double contencion : contenciones) {
+        for (int numHilos : numerosHilos) {
+            ArbolConcurrente concurrente;
+            ArbolSistemaArchivos global;
+            for (const std::string& ruta : todasLasRutas) {
+                concurrente.insertarRuta(ruta);
+                global.insertarRuta(ruta);
+            }
+            for (const std::string& directorio : todosLosDirectorios) {
+                concurrente.insertarRuta(directorio);
+                global.insertarRuta(directorio);
+            }
+
+            double porSubarbol = medirInsercionConcurrente(concurrente, todosLosDirectorios, numHilos, contencion);
+            double conGlobal = medirInsercionCerrojoGlobal(global, todosLosDirectorios, numHilos, contencion);
+
+            std::cout << std::left << std::setw(8) << numHilos
+                      << std::setw(13) << std::fixed << std::setprecision(1) << contencion
+                      << std::setw(22) << std::fixed << std::setprecision(0) << porSubarbol
+                      << std::setw(22) << std::fixed << std::setprecision(0) << conGlobal
+                      << std::setw(12) << std::fixed << std::setprecision(2)
+                      << (conGlobal > 0.0 ? porSubarbol / conGlobal : 0.0) << std::endl;
+        }
+    }
+
+    std::cout << std::string(77, '-') << std::endl;
+}
+
 // Función para ejecutar experimentos completos
 ResultadoExperimento ejecutarExperimento(const std::string& rutaBase, int numDirectorios, int numArchivos) {
     std::cout << "\n=== Ejecutando experimento ===" << std::endl;
@@ -183,10 +365,27 @@ ResultadoExperimento ejecutarExperimento(const std::string& rutaBase, int numDir
     std::cout << "Rutas encontradas: " << todasLasRutas.size() << std::endl;
     std::cout << "Directorios encontrados: " << todosLosDirectorios.size() << std::endl;
     
+    // Huella antes de buscar: las búsquedas construyen índices de hijos que la copia DAG no tiene,
+    // así que ambos árboles se comparan sin índices
+    long long bytesSinIndices = arbol.estadisticasMemoria().total();
+    
     // Medir tiempo de búsqueda
     std::cout << "Midiendo tiempo de búsqueda..." << std::endl;
     resultado.tiempoBusqueda = medirTiempoBusqueda(arbol, todasLasRutas);
     
+    // Misma búsqueda sobre una copia con los subárboles idénticos compartidos (DAG)
+    std::cout << "Midiendo búsqueda con subárboles compartidos..." << std::endl;
+    {
+        ArbolSistemaArchivos dag(arbol);
+        dag.compartirSubarboles();
+        EstadisticasMemoria memoriaDag = dag.estadisticasMemoria();
+        resultado.nodosCompartido = memoriaDag.nodos;
+        resultado.bytesCompartido = memoriaDag.total();
+        resultado.razonCompresion = static_cast<double>(dag.obtenerNumeroNodos()) / static_cast<double>(memoriaDag.nodos);
+        resultado.razonMemoria = static_cast<double>(bytesSinIndices) / static_cast<double>(memoriaDag.total());
+        resultado.tiempoBusquedaCompartido = medirTiempoBusqueda(dag, todasLasRutas);
+    }
+    
     // Medir tiempo de eliminación
     std::cout << "Midiendo tiempo de eliminación..." << std::endl;
     resultado.tiempoEliminacion = medirTiempoEliminacion(arbol, todasLasRutas);
@@ -199,6 +398,18 @@ ResultadoExperimento ejecutarExperimento(const std::string& rutaBase, int numDir
     resultado.alturaArbol = arbol.obtenerAltura();
     resultado.numeroNodos = arbol.obtenerNumeroNodos();
     
+    // Huella de memoria antes y después de recortar la holgura
+    EstadisticasMemoria memoria = arbol.estadisticasMemoria();
+    mostrarEstadisticasMemoria(memoria);
+    resultado.bytesNodos = memoria.bytesNodos;
+    resultado.bytesNombres = memoria.bytesNombres;
+    resultado.bytesHijos = memoria.bytesHijos;
+    resultado.bytesHolgura = memoria.bytesHolgura;
+    resultado.bytesSobrecarga = memoria.bytesSobrecarga;
+    resultado.bytesTotal = memoria.total();
+    arbol.reducirMemoria();
+    resultado.bytesReducidos = arbol.estadisticasMemoria().total();
+    
     std::cout << "Experimento completado." << std::endl;
     return resultado;
 }
@@ -234,7 +445,9 @@ void guardarResultados(const std::vector<ResultadoExperimento>& resultados, cons
     }
     
     // Escribir encabezados
-    archivo << "NumDirectorios,NumArchivos,TiempoCreacion(ms),TiempoBusqueda(ns),TiempoEliminacion(ns),TiempoInsercion(ns),AlturaArbol,NumeroNodos" << std::endl;
+    archivo << "NumDirectorios,NumArchivos,TiempoCreacion(ms),TiempoBusqueda(ns),TiempoEliminacion(ns),TiempoInsercion(ns),AlturaArbol,NumeroNodos,"
+            << "BytesNodos,BytesNombres,BytesHijos,BytesHolgura,BytesSobrecarga,BytesTotal,BytesTrasReducir,"
+            << "NodosCompartido,BytesCompartido,RazonCompresion,RazonMemoria,TiempoBusquedaCompartido(ns)" << std::endl;
     
     // Escribir datos
     for (const auto& resultado : resultados) {
@@ -245,7 +458,19 @@ void guardarResultados(const std::vector<ResultadoExperimento>& resultados, cons
                 << std::fixed << std::setprecision(2) << resultado.tiempoEliminacion << ","
                 << std::fixed << std::setprecision(2) << resultado.tiempoInsercion << ","
                 << resultado.alturaArbol << ","
-                << resultado.numeroNodos << std::endl;
+                << resultado.numeroNodos << ","
+                << resultado.bytesNodos << ","
+                << resultado.bytesNombres << ","
+                << resultado.bytesHijos << ","
+                << resultado.bytesHolgura << ","
+                << resultado.bytesSobrecarga << ","
+                << resultado.bytesTotal << ","
+                << resultado.bytesReducidos << ","
+                << resultado.nodosCompartido << ","
+                << resultado.bytesCompartido << ","
+                << std::fixed << std::setprecision(3) << resultado.razonCompresion << ","
+                << resultado.razonMemoria << ","
+                << std::fixed << std::setprecision(2) << resultado.tiempoBusquedaCompartido << std::endl;
     }
     
     archivo.close();
@@ -278,6 +503,48 @@ void mostrarResumen(const std::vector<ResultadoExperimento>& resultados) {
     }
     
     std::cout << std::string(110, '-') << std::endl;
+    
+    std::cout << "\n=== SUBÁRBOLES COMPARTIDOS (DAG) ===" << std::endl;
+    std::cout << std::left << std::setw(15) << "Configuración"
+              << std::setw(16) << "Nodos físicos"
+              << std::setw(15) << "Compresión"
+              << std::setw(14) << "Memoria (x)"
+              << std::setw(16) << "Búsqueda (ns)"
+              << std::setw(20) << "Búsqueda DAG (ns)" << std::endl;
+    
+    std::cout << std::string(96, '-') << std::endl;
+    
+    for (const auto& resultado : resultados) {
+        std::string config = std::to_string(resultado.numDirectorios) + "/" + std::to_string(resultado.numArchivos);
+        
+        std::cout << std::left << std::setw(15) << config
+                  << std::setw(16) << resultado.nodosCompartido
+                  << std::setw(15) << std::fixed << std::setprecision(2) << resultado.razonCompresion
+                  << std::setw(14) << resultado.razonMemoria
+                  << std::setw(16) << resultado.tiempoBusqueda
+                  << std::setw(20) << resultado.tiempoBusquedaCompartido << std::endl;
+    }
+    
+    std::cout << std::string(96, '-') << std::endl;
+}
+
+// Función para mostrar la huella de memoria y el histograma de grado de los directorios
+void mostrarEstadisticasMemoria(const EstadisticasMemoria& estadisticas) {
+    auto enMiB = [](long long bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+
+    std::cout << "Memoria del árbol (" << estadisticas.nodos << " nodos): "
+              << std::fixed << std::setprecision(2) << enMiB(estadisticas.total()) << " MiB" << std::endl;
+    std::cout << "  Cabeceras de nodo: " << enMiB(estadisticas.bytesNodos) << " MiB" << std::endl;
+    std::cout << "  Nombres (heap):    " << enMiB(estadisticas.bytesNombres) << " MiB" << std::endl;
+    std::cout << "  Arreglos de hijos: " << enMiB(estadisticas.bytesHijos) << " MiB" << std::endl;
+    std::cout << "  Holgura:           " << enMiB(estadisticas.bytesHolgura) << " MiB" << std::endl;
+    std::cout << "  Asignador:         " << enMiB(estadisticas.bytesSobrecarga) << " MiB" << std::endl;
+
+    std::cout << "Histograma de grado de directorios:" << std::endl;
+    for (size_t i = 0; i < estadisticas.histogramaGrado.size(); ++i) {
+        long long desde = 1LL << i;
+        std::cout << "  [" << desde << ", " << (desde * 2 - 1) << "]: " << estadisticas.histogramaGrado[i] << std::endl;
+    }
 }
 
 // Función para limpiar directorios de prueba
@@ -296,3 +563,1143 @@ void limpiarDirectoriosPrueba(const std::string& rutaBase) {
         }
     }
 }
+
+
+// Función para vaciar la caché de páginas del kernel (requiere privilegios de root)
+bool vaciarCachePaginas() {
+    sync();
+    std::ofstream dropCaches("/proc/sys/vm/drop_caches");
+    if (!dropCaches.is_open()) return false;
+    dropCaches << "3" << std::endl;
+    return static_cast<bool>(dropCaches);
+}
+
+// Función para comparar los cargadores con metadatos en caché fría y caliente
+void compararCargaMetadatos(const std::string& rutaDatos, unsigned profundidadCola) {
+    const std::vector<std::pair<ModoCarga, std::string>> modos = {
+        {ModoCarga::Iterador, "Iterador+lstat"},
+        {ModoCarga::Sincrono, "getdents+statx"},
+        {ModoCarga::IoUring, "io_uring"}
+    };
+
+    std::cout << "\n=== CARGA CON METADATOS (profundidad de cola " << profundidadCola << ") ===" << std::endl;
+    std::cout << std::left << std::setw(18) << "Modo"
+              << std::setw(10) << "Caché"
+              << std::setw(12) << "Entradas"
+              << std::setw(14) << "Tiempo (ms)"
+              << std::setw(16) << "Entradas/s"
+              << std::setw(12) << "Syscalls" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (const char* cache : {"fría", "caliente"}) {
+        for (const auto& [modo, nombre] : modos) {
+            if (std::string(cache) == "fría" && !vaciarCachePaginas()) {
+                std::cerr << "Aviso: no se pudo vaciar la caché de páginas; la medición 'fría' es en realidad caliente" << std::endl;
+            }
+
+            ArbolSistemaArchivos arbol;
+            EstadisticasCarga estadisticas = arbol.cargarDatosConMetadatos(rutaDatos, modo, profundidadCola);
+            double porSegundo = estadisticas.tiempoMs > 0.0
+                ? static_cast<double>(estadisticas.entradas) / (estadisticas.tiempoMs / 1000.0) : 0.0;
+            std::string etiqueta = estadisticas.modo == modo ? nombre : nombre + " (sync)";
+
+            std::cout << std::left << std::setw(18) << etiqueta
+                      << std::setw(10) << cache
+                      << std::setw(12) << estadisticas.entradas
+                      << std::setw(14) << std::fixed << std::setprecision(3) << estadisticas.tiempoMs
+                      << std::setw(16) << std::fixed << std::setprecision(0) << porSegundo
+                      << std::setw(12) << estadisticas.llamadasSistema << std::endl;
+        }
+    }
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << "Nota: en modo Iterador solo se cuentan los lstat; las lecturas de directorio del iterador no son visibles." << std::endl;
+}
+
+
+// Función para medir el costo del diario de mutaciones y el tiempo de recuperación
+void medirMutacionesConDiario(const std::string& rutaDatos, const std::string& directorioTrabajo) {
+    ArbolSistemaArchivos base;
+    base.cargarDatos(rutaDatos);
+    std::vector<std::string> todosLosDirectorios = base.obtenerTodosLosDirectorios();
+    if (todosLosDirectorios.empty()) {
+        std::cout << "El directorio no contiene subdirectorios donde insertar." << std::endl;
+        return;
+    }
+
+    // Secuencia fija de mutaciones: dos inserciones por cada eliminación de algo ya insertado
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> distDir(0, todosLosDirectorios.size() - 1);
+    std::uniform_int_distribution<size_t> distArchivo(0, NOMBRES_ARCHIVOS.size() - 1);
+    std::vector<std::pair<bool, std::string>> mutaciones;
+    std::vector<std::string> insertadas;
+    for (int i = 0; i < NUM_MUTACIONES_DIARIO; ++i) {
+        if (i % 3 == 2) {
+            std::uniform_int_distribution<size_t> distInsertada(0, insertadas.size() - 1);
+            mutaciones.push_back({false, insertadas[distInsertada(gen)]});
+        } else {
+            insertadas.push_back(todosLosDirectorios[distDir(gen)] + "/" + NOMBRES_ARCHIVOS[distArchivo(gen)] +
+                                 "_diario_" + std::to_string(i));
+            mutaciones.push_back({true, insertadas.back()});
+        }
+    }
+
+    struct Variante {
+        std::string nombre;
+        bool conDiario;
+        bool sincronizar;
+        int tamanoGrupo;
+        long long registrosPorPuntoControl;
+    };
+    const std::vector<Variante> variantes = {
+        {"Sin diario", false, false, 1, 0},
+        {"Sin fdatasync", true, false, 256, 0},
+        {"Grupo 1", true, true, 1, 0},
+        {"Grupo 16", true, true, 16, 0},
+        {"Grupo 256", true, true, 256, 0},
+        {"Grupo 4096", true, true, 4096, 0},
+        {"G256+PC/5000", true, true, 256, 5000}
+    };
+
+    ConfiguracionDiario configuracion;
+    configuracion.rutaDiario = directorioTrabajo + "/arbol.diario";
+    configuracion.rutaPuntoControl = directorioTrabajo + "/arbol.puntocontrol";
+
+    std::cout << "\n=== DIARIO DE MUTACIONES (" << NUM_MUTACIONES_DIARIO << " mutaciones) ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "Variante"
+              << std::setw(16) << "Mutaciones/s"
+              << std::setw(14) << "fdatasync"
+              << std::setw(10) << "Durable"
+              << std::setw(16) << "Diario (bytes)" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+
+    int nodosEsperados = 0;
+    for (const Variante& variante : variantes) {
+        ArbolSistemaArchivos arbol;
+        arbol.cargarDatos(rutaDatos);
+        std::filesystem::remove(configuracion.rutaDiario);
+        std::filesystem::remove(configuracion.rutaPuntoControl);
+
+        configuracion.sincronizar = variante.sincronizar;
+        configuracion.tamanoGrupo = variante.tamanoGrupo;
+        configuracion.registrosPorPuntoControl = variante.registrosPorPuntoControl;
+        DiarioMutaciones diario(configuracion);
+        if (variante.conDiario) {
+            if (!diario.abierto()) return;
+            diario.guardarPuntoControl(arbol); // Base para la recuperación
+            arbol.adjuntarDiario(&diario);
+        }
+        long long sincronizacionesIniciales = diario.obtenerSincronizaciones();
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        for (const auto& [esInsercion, ruta] : mutaciones) {
+            if (esInsercion) {
+                arbol.insertar(ruta);
+            } else {
+                arbol.eliminar(ruta);
+            }
+        }
+        bool confirmado = diario.confirmar();
+        auto fin = std::chrono::high_resolution_clock::now();
+        if (variante.conDiario && !confirmado) {
+            std::cout << variante.nombre << ": el diario falló, mutaciones rechazadas" << std::endl;
+        }
+
+        arbol.adjuntarDiario(nullptr);
+        nodosEsperados = arbol.obtenerNumeroNodos();
+        auto duracion = std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio);
+        double segundos = static_cast<double>(duracion.count()) / 1e9;
+        std::uintmax_t bytesDiario = variante.conDiario ? std::filesystem::file_size(configuracion.rutaDiario) : 0;
+        bool durable = variante.conDiario && diario.durable();
+
+        std::cout << std::left << std::setw(16) << variante.nombre
+                  << std::setw(16) << std::fixed << std::setprecision(0)
+                  << static_cast<double>(mutaciones.size()) / segundos
+                  << std::setw(14) << diario.obtenerSincronizaciones() - sincronizacionesIniciales
+                  << std::setw(durable ? 11 : 10) << (durable ? "sí" : "no") // "í" ocupa dos bytes
+                  << std::setw(16) << bytesDiario << std::endl;
+    }
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << "Durable: cada mutación está en disco al retornar. Con grupos de N registros una caída"
+              << " puede perder hasta N-1 mutaciones ya confirmadas." << std::endl;
+
+    // Recuperación a partir de la última variante (último punto de control + cola del diario)
+    auto inicio = std::chrono::high_resolution_clock::now();
+    ArbolSistemaArchivos recuperado;
+    long long reproducidos = recuperarArbol(recuperado, configuracion);
+    auto fin = std::chrono::high_resolution_clock::now();
+    double tiempoRecuperacion = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()) / 1000.0;
+
+    double tiempoRecorrido = medirTiempoCreacion(rutaDatos);
+
+    std::cout << "Recuperación (punto de control + " << reproducidos << " registros): "
+              << std::fixed << std::setprecision(3) << tiempoRecuperacion << " ms" << std::endl;
+    std::cout << "Re-recorrido con cargarDatos: " << tiempoRecorrido << " ms (sin las mutaciones)" << std::endl;
+    std::cout << "Nodos recuperados: " << recuperado.obtenerNumeroNodos() << " (esperados " << nodosEsperados << ")" << std::endl;
+}
+
+// Función para obtener la ruta del nodo 'indice' de un árbol k-ario completo numerado por niveles
+// (la raíz es el 0 y el padre de i es (i-1)/grado)
+std::string rutaSintetica(long long indice, int grado) {
+    std::vector<long long> ancestros;
+    for (long long i = indice; i > 0; i = (i - 1) / grado) {
+        ancestros.push_back(i);
+    }
+
+    std::string ruta;
+    for (auto it = ancestros.rbegin(); it != ancestros.rend(); ++it) {
+        if (!ruta.empty()) ruta += '/';
+        ruta += 'n';
+        ruta += std::to_string(*it);
+    }
+    return ruta;
+}
+
+// Función para generar en memoria un árbol k-ario completo de numNodos nodos (raíz incluida)
+void generarArbolSintetico(ArbolSistemaArchivos& arbol, long long numNodos, int grado) {
+    arbol.insertarRuta("");
+    for (long long i = 1; i < numNodos; ++i) {
+        arbol.insertarRuta(rutaSintetica(i, grado));
+    }
+}
+
+// Función para comparar la diferencia nativa con el diff de listas de rutas
+void medirDiferencia(const std::vector<long long>& tamanos, const std::vector<double>& tasasCambio) {
+    const int grado = 16;
+    if (tamanos.empty() || tasasCambio.empty()) {
+        std::cerr << "Se necesita al menos un tamaño y una tasa de cambio" << std::endl;
+        return;
+    }
+    for (long long numNodos : tamanos) {
+        if (numNodos < 2) {
+            std::cerr << "Tamaño inválido: " << numNodos << " (se necesitan al menos 2 nodos)" << std::endl;
+            return;
+        }
+    }
+    for (double tasa : tasasCambio) {
+        if (!(tasa > 0.0 && tasa <= 1.0)) {
+            std::cerr << "Tasa de cambio inválida: " << tasa << " (debe estar en (0, 1])" << std::endl;
+            return;
+        }
+    }
+    auto milisegundos = [](auto inicio, auto fin) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()) / 1000.0;
+    };
+
+    std::cout << "\n=== DIFERENCIA ENTRE ÁRBOLES (grado " << grado << ") ===" << std::endl;
+    std::cout << std::left << std::setw(11) << "Nodos"
+              << std::setw(10) << "Tasa"
+              << std::setw(10) << "Cambios"
+              << std::setw(14) << "Hash ini (ms)"
+              << std::setw(16) << "diferencia (ms)"
+              << std::setw(16) << "Diff rutas (ms)"
+              << std::setw(15) << "fusionar (ms)"
+              << std::setw(10) << "Correcto" << std::endl;
+    std::cout << std::string(102, '-') << std::endl;
+
+    for (long long numNodos : tamanos) {
+        ArbolSistemaArchivos a;
+        generarArbolSintetico(a, numNodos, grado);
+
+        // Costo único: calcular los hashes de todo el árbol (luego quedan en caché)
+        auto inicio = std::chrono::high_resolution_clock::now();
+        a.hashArbol();
+        auto fin = std::chrono::high_resolution_clock::now();
+        double tiempoHash = milisegundos(inicio, fin);
+
+        for (double tasa : tasasCambio) {
+            // b es una copia de a (con hashes) a la que se aplican cambios aleatorios
+            ArbolSistemaArchivos b(a);
+            std::mt19937_64 gen(7);
+            std::uniform_int_distribution<long long> distNodo(1, numNodos - 1);
+            long long numCambios = std::max(1LL, static_cast<long long>(tasa * static_cast<double>(numNodos)));
+            for (long long c = 0; c < numCambios; ++c) {
+                long long indice = distNodo(gen);
+                if (indice * grado + 1 >= numNodos) {
+                    b.eliminar(rutaSintetica(indice, grado)); // Hoja
+                } else {
+                    b.insertar(rutaSintetica(indice, grado) + "/nuevo_" + std::to_string(c));
+                }
+            }
+
+            long long cambios = 0;
+            inicio = std::chrono::high_resolution_clock::now();
+            diferencia(a, b, [&cambios](TipoCambio, const std::string&, const NodoArbol*) { cambios++; });
+            fin = std::chrono::high_resolution_clock::now();
+            double tiempoDiferencia = milisegundos(inicio, fin);
+
+            // Referencia: volcar ambos árboles a listas de rutas y compararlas ordenadas
+            inicio = std::chrono::high_resolution_clock::now();
+            std::vector<std::string> rutasA = a.obtenerTodasLasRutas();
+            std::vector<std::string> rutasB = b.obtenerTodasLasRutas();
+            std::sort(rutasA.begin(), rutasA.end());
+            std::sort(rutasB.begin(), rutasB.end());
+            std::vector<std::string> distintas;
+            std::set_symmetric_difference(rutasA.begin(), rutasA.end(), rutasB.begin(), rutasB.end(),
+                                          std::back_inserter(distintas));
+            fin = std::chrono::high_resolution_clock::now();
+            double tiempoRutas = milisegundos(inicio, fin);
+            rutasA.clear();
+            rutasA.shrink_to_fit();
+            rutasB.clear();
+            rutasB.shrink_to_fit();
+
+            // Aplicar el delta a una tercera copia y comprobar que queda igual a b: por hash y
+            // también por rutas, para no depender solo de que el hash no colisione
+            ArbolSistemaArchivos c(a);
+            inicio = std::chrono::high_resolution_clock::now();
+            fusionar(c, a, b);
+            fin = std::chrono::high_resolution_clock::now();
+            double tiempoFusion = milisegundos(inicio, fin);
+            bool correcto = c.hashArbol() == b.hashArbol() && c.obtenerTodasLasRutas() == b.obtenerTodasLasRutas();
+
+            std::cout << std::left << std::setw(11) << numNodos
+                      << std::setw(10) << std::defaultfloat << tasa
+                      << std::setw(10) << cambios
+                      << std::setw(14) << std::fixed << std::setprecision(3) << tiempoHash
+                      << std::setw(16) << tiempoDiferencia
+                      << std::setw(16) << tiempoRutas
+                      << std::setw(15) << tiempoFusion
+                      << std::setw(10) << (correcto ? "sí" : "NO") << std::endl;
+        }
+    }
+
+    std::cout << std::string(102, '-') << std::endl;
+}
+
+// Función para obtener la ruta del nodo 'indice' de un bosque de cadenas: cada cadena "c<i>" baja
+// 'profundidad' niveles "d1/d2/..." y cada nivel tiene el subdirectorio siguiente más grado-1 archivos
+std::string rutaEnCadena(long long indice, int grado, int profundidad) {
+    long long porCadena = static_cast<long long>(grado) * profundidad;
+    long long resto = indice % porCadena;
+    long long nivel = resto / grado + 1;
+    long long posicion = resto % grado;
+
+    std::string ruta = "c";
+    ruta += std::to_string(indice / porCadena);
+    for (long long j = 1; j <= nivel; ++j) {
+        ruta += "/d";
+        ruta += std::to_string(j);
+    }
+    if (posicion > 0) {
+        ruta += "/f";
+        ruta += std::to_string(posicion);
+    }
+    return ruta;
+}
+
+namespace {
+
+const double UMBRAL_CODO = 0.3; // Aumento de la pendiente log-log que se marca como codo
+
+struct MuestraBarrido {
+    std::string eje;
+    long long nodos;
+    int grado;
+    int profundidad;
+    int semilla;
+    int altura;
+    double profundidadMedia; // Componentes promedio de las rutas consultadas
+    long long bytes;
+    double cargaMs;
+    double buscarNs;
+    double insertarNs;
+    double eliminarNs;
+};
+
+// Valores geométricos desde 'minimo' hasta 'maximo' (ambos incluidos, sin repetidos)
+std::vector<long long> pasosGeometricos(long long minimo, long long maximo, double factor) {
+    std::vector<long long> pasos;
+    if (factor <= 1.0) factor = 2.0;
+    for (double valor = static_cast<double>(minimo); valor < static_cast<double>(maximo); valor *= factor) {
+        long long redondeado = std::llround(valor);
+        if (pasos.empty() || redondeado != pasos.back()) pasos.push_back(redondeado);
+    }
+    pasos.push_back(maximo);
+    return pasos;
+}
+
+// Barrera para que el compilador no descarte (ni elida la asignación de) un valor que se calcula
+// solo para medir su costo: lo trata como leído por código que no puede ver
+template <typename T>
+inline void noDescartar(const T& valor) {
+    asm volatile("" : : "m"(valor) : "memory");
+}
+
+// Tamaño de la caché de último nivel según sysfs (0 si no se puede leer)
+long long tamanoCacheUltimoNivel() {
+    for (int indice = 4; indice >= 0; --indice) {
+        std::ifstream archivo("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(indice) + "/size");
+        std::string texto;
+        if (!(archivo >> texto) || texto.empty()) continue;
+
+        long long valor = std::atoll(texto.c_str());
+        char unidad = texto.back();
+        if (unidad == 'K') valor *= 1024;
+        if (unidad == 'M') valor *= 1024 * 1024;
+        return valor;
+    }
+    return 0;
+}
+
+// Mide carga, búsqueda, inserción y eliminación de un árbol sintético cuyas rutas da 'ruta'
+template <typename GeneradorRuta>
+MuestraBarrido medirPuntoBarrido(GeneradorRuta ruta, long long numNodos, int operaciones, int semilla) {
+    auto nanosegundos = [](auto inicio, auto fin) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count());
+    };
+    MuestraBarrido muestra{};
+    muestra.nodos = numNodos;
+    muestra.semilla = semilla;
+
+    // Carga: se descuenta el costo de armar las rutas para medir solo insertarRuta
+    ArbolSistemaArchivos arbol;
+    auto inicio = std::chrono::high_resolution_clock::now();
+    for (long long i = 0; i < numNodos; ++i) {
+        noDescartar(ruta(i));
+    }
+    auto fin = std::chrono::high_resolution_clock::now();
+    double soloRutas = nanosegundos(inicio, fin);
+
+    inicio = std::chrono::high_resolution_clock::now();
+    for (long long i = 0; i < numNodos; ++i) {
+        arbol.insertarRuta(ruta(i));
+    }
+    fin = std::chrono::high_resolution_clock::now();
+    muestra.cargaMs = std::max(0.0, nanosegundos(inicio, fin) - soloRutas) / 1e6;
+
+    // Consultas y nuevas hojas preparadas fuera de la medición
+    std::mt19937_64 gen(static_cast<std::uint64_t>(semilla));
+    std::uniform_int_distribution<long long> distNodo(0, numNodos - 1);
+    std::vector<std::string> consultas, nuevas;
+    consultas.reserve(static_cast<size_t>(operaciones));
+    nuevas.reserve(static_cast<size_t>(operaciones));
+    long long componentes = 0;
+    for (int i = 0; i < operaciones; ++i) {
+        consultas.push_back(ruta(distNodo(gen)));
+        componentes += static_cast<long long>(std::count(consultas.back().begin(), consultas.back().end(), '/')) + 1;
+
+        std::string padre = ruta(distNodo(gen));
+        size_t corte = padre.rfind('/');
+        padre = corte == std::string::npos ? "" : padre.substr(0, corte + 1);
+        nuevas.push_back(padre + "barrido_" + std::to_string(i));
+    }
+    muestra.profundidadMedia = static_cast<double>(componentes) / operaciones;
+    muestra.altura = arbol.obtenerAltura();
+    muestra.bytes = arbol.estadisticasMemoria().total();
+
+    inicio = std::chrono::high_resolution_clock::now();
+    for (const std::string& consulta : consultas) {
+        arbol.buscar(consulta);
+    }
+    fin = std::chrono::high_resolution_clock::now();
+    muestra.buscarNs = nanosegundos(inicio, fin) / operaciones;
+
+    inicio = std::chrono::high_resolution_clock::now();
+    for (const std::string& nueva : nuevas) {
+        arbol.insertar(nueva);
+    }
+    fin = std::chrono::high_resolution_clock::now();
+    muestra.insertarNs = nanosegundos(inicio, fin) / operaciones;
+
+    // Eliminar en otro orden las hojas recién insertadas deja el árbol como estaba
+    std::shuffle(nuevas.begin(), nuevas.end(), gen);
+    inicio = std::chrono::high_resolution_clock::now();
+    for (const std::string& nueva : nuevas) {
+        arbol.eliminar(nueva);
+    }
+    fin = std::chrono::high_resolution_clock::now();
+    muestra.eliminarNs = nanosegundos(inicio, fin) / operaciones;
+
+    return muestra;
+}
+
+double mediana(std::vector<double> valores) {
+    std::sort(valores.begin(), valores.end());
+    size_t mitad = valores.size() / 2;
+    return valores.size() % 2 ? valores[mitad] : (valores[mitad - 1] + valores[mitad]) / 2.0;
+}
+
+// Coeficiente R² del ajuste por mínimos cuadrados y = a + b·x (-1 si x no varía; con -ffast-math no hay NaN)
+double ajusteR2(const std::vector<double>& x, const std::vector<double>& y) {
+    double n = static_cast<double>(x.size());
+    double mediaX = 0.0, mediaY = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        mediaX += x[i] / n;
+        mediaY += y[i] / n;
+    }
+
+    double sxx = 0.0, sxy = 0.0, syy = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxx += (x[i] - mediaX) * (x[i] - mediaX);
+        sxy += (x[i] - mediaX) * (y[i] - mediaY);
+        syy += (y[i] - mediaY) * (y[i] - mediaY);
+    }
+    if (x.size() < 3 || sxx <= 1e-12 * std::max(1.0, mediaX * mediaX) || syy <= 0.0) return -1.0;
+
+    double pendiente = sxy / sxx;
+    if (pendiente < 0.0) return 0.0; // Un costo que decrece no sigue ningún modelo de crecimiento
+    return (pendiente * sxy) / syy;
+}
+
+// Resume un eje: medianas por punto, ajuste a cada modelo y codos en la curva
+void resumirEje(const std::string& eje, const std::vector<MuestraBarrido>& muestras, long long cacheUltimoNivel) {
+    // Agrupar las semillas de cada punto (las muestras llegan en orden de punto)
+    std::vector<std::vector<const MuestraBarrido*>> puntos;
+    for (const MuestraBarrido& muestra : muestras) {
+        if (muestra.eje != eje) continue;
+        const MuestraBarrido* anterior = puntos.empty() ? nullptr : puntos.back().front();
+        if (!anterior || anterior->nodos != muestra.nodos || anterior->grado != muestra.grado ||
+            anterior->profundidad != muestra.profundidad) {
+            puntos.emplace_back();
+        }
+        puntos.back().push_back(&muestra);
+    }
+    if (puntos.empty()) return;
+
+    const std::vector<std::string> operaciones = {"carga", "buscar", "insertar", "eliminar"};
+    auto valor = [](const MuestraBarrido* m, size_t operacion) {
+        switch (operacion) {
+            case 0: return m->cargaMs;
+            case 1: return m->buscarNs;
+            case 2: return m->insertarNs;
+            default: return m->eliminarNs;
+        }
+    };
+    auto abscisa = [&eje](const MuestraBarrido* m) {
+        return static_cast<double>(eje == "nodos" ? m->nodos : eje == "grado" ? m->grado : m->profundidad);
+    };
+
+    std::vector<double> x, logN, profLogK, lineal, bytes;
+    std::vector<std::vector<double>> medianas(operaciones.size());
+
+    std::cout << "\n--- Eje " << eje << " ---" << std::endl;
+    std::cout << std::left << std::setw(10) << "Nodos" << std::setw(7) << "Grado" << std::setw(7) << "Prof"
+              << std::setw(8) << "Altura" << std::setw(10) << "MiB" << std::setw(12) << "Carga (ms)"
+              << std::setw(13) << "Buscar (ns)" << std::setw(15) << "Insertar (ns)" << std::setw(15) << "Eliminar (ns)" << std::endl;
+    for (const auto& semillas : puntos) {
+        const MuestraBarrido* m = semillas.front();
+        x.push_back(abscisa(m));
+        logN.push_back(std::log2(static_cast<double>(m->nodos)));
+        profLogK.push_back(m->profundidadMedia * std::log2(static_cast<double>(m->grado)));
+        lineal.push_back(static_cast<double>(m->nodos));
+        bytes.push_back(static_cast<double>(m->bytes));
+        for (size_t op = 0; op < operaciones.size(); ++op) {
+            std::vector<double> valores;
+            for (const MuestraBarrido* s : semillas) valores.push_back(valor(s, op));
+            medianas[op].push_back(mediana(valores));
+        }
+
+        std::cout << std::left << std::setw(10) << m->nodos << std::setw(7) << m->grado << std::setw(7) << (m->profundidad > 0 ? std::to_string(m->profundidad) : "-")
+                  << std::setw(8) << m->altura << std::setw(10) << std::fixed << std::setprecision(1)
+                  << static_cast<double>(m->bytes) / (1024.0 * 1024.0)
+                  << std::setw(12) << std::setprecision(2) << medianas[0].back()
+                  << std::setw(13) << std::setprecision(1) << medianas[1].back()
+                  << std::setw(15) << medianas[2].back() << std::setw(15) << medianas[3].back() << std::endl;
+    }
+
+    // Ajustes: el modelo con mayor R² es el que mejor explica la curva en este eje
+    const std::vector<std::pair<std::string, const std::vector<double>*>> modelos = {
+        {"log n", &logN}, {"prof·log k", &profLogK}, {"n", &lineal}};
+    std::cout << "Ajuste R²    ";
+    for (const auto& modelo : modelos) std::cout << std::setw(13) << modelo.first;
+    std::cout << "Mejor" << std::endl;
+    for (size_t op = 0; op < operaciones.size(); ++op) {
+        std::cout << std::left << std::setw(13) << operaciones[op];
+        std::string mejor = "-";
+        double mejorR2 = 0.0;
+        for (const auto& modelo : modelos) {
+            double r2 = ajusteR2(*modelo.second, medianas[op]);
+            std::cout << std::setw(13) << (r2 < 0.0 ? std::string("-") : std::to_string(r2).substr(0, 5));
+            if (r2 > mejorR2) {
+                mejorR2 = r2;
+                mejor = modelo.first;
+            }
+        }
+        std::cout << mejor << std::endl;
+    }
+
+    // Codos: la pendiente log-log entre puntos consecutivos sube bruscamente y el costo pasa a crecer
+    bool hayCodos = false;
+    for (size_t op = 0; op < operaciones.size(); ++op) {
+        double pendienteAnterior = 0.0;
+        bool hayAnterior = false;
+        for (size_t i = 1; i < x.size(); ++i) {
+            if (medianas[op][i] <= 0.0 || medianas[op][i - 1] <= 0.0 || x[i] <= x[i - 1]) continue;
+            double pendiente = std::log(medianas[op][i] / medianas[op][i - 1]) / std::log(x[i] / x[i - 1]);
+            if (hayAnterior && pendiente > 0.0 && pendiente - pendienteAnterior > UMBRAL_CODO) {
+                hayCodos = true;
+                std::cout << "Codo en " << operaciones[op] << ": entre " << eje << "=" << std::llround(x[i - 1]) << " y " << std::llround(x[i])
+                          << " la pendiente log-log sube de " << std::setprecision(2) << pendienteAnterior
+                          << " a " << pendiente << " (árbol de " << std::setprecision(1) << bytes[i] / (1024.0 * 1024.0) << " MiB";
+                if (cacheUltimoNivel > 0) {
+                    std::cout << (bytes[i] > static_cast<double>(cacheUltimoNivel) ? ", ya no cabe" : ", cabe")
+                              << " en la LLC de " << cacheUltimoNivel / (1024 * 1024) << " MiB";
+                }
+                std::cout << ")" << std::endl;
+            }
+            pendienteAnterior = pendiente;
+            hayAnterior = true;
+        }
+    }
+    if (!hayCodos) {
+        std::cout << "Sin codos (umbral de pendiente " << UMBRAL_CODO << ")" << std::endl;
+    }
+}
+
+} // namespace
+
+// Función para barrer nodos, grado y profundidad, guardar cada muestra en CSV y resumir los ajustes
+void ejecutarBarridoComplejidad(const ConfiguracionBarrido& configuracion) {
+    std::vector<MuestraBarrido> muestras;
+    auto medir = [&](const std::string& eje, long long numNodos, int grado, int profundidad, auto ruta) {
+        for (int semilla = 1; semilla <= configuracion.semillas; ++semilla) {
+            MuestraBarrido muestra = medirPuntoBarrido(ruta, numNodos, configuracion.operaciones, semilla);
+            muestra.eje = eje;
+            muestra.grado = grado;
+            muestra.profundidad = profundidad;
+            muestras.push_back(muestra);
+        }
+        std::cout << "  " << eje << ": " << numNodos << " nodos, grado " << grado << ", profundidad "
+                  << profundidad << " listo" << std::endl;
+    };
+
+    std::cout << "\n=== BARRIDO DE COMPLEJIDAD (" << configuracion.semillas << " semillas, "
+              << configuracion.operaciones << " operaciones por punto) ===" << std::endl;
+
+    for (long long numNodos : pasosGeometricos(configuracion.nodosMin, configuracion.nodosMax, configuracion.factorNodos)) {
+        int grado = configuracion.gradoFijo;
+        medir("nodos", numNodos, grado, 0, [grado](long long i) { return rutaSintetica(i, grado); });
+    }
+    for (long long paso : pasosGeometricos(configuracion.gradoMin, configuracion.gradoMax, configuracion.factorGrado)) {
+        int grado = static_cast<int>(paso);
+        medir("grado", configuracion.nodosFijos, grado, 0, [grado](long long i) { return rutaSintetica(i, grado); });
+    }
+    for (long long paso : pasosGeometricos(configuracion.profundidadMin, configuracion.profundidadMax,
+                                           configuracion.factorProfundidad)) {
+        int grado = configuracion.gradoFijo;
+        int profundidad = static_cast<int>(paso);
+        medir("profundidad", configuracion.nodosFijos, grado, profundidad,
+              [grado, profundidad](long long i) { return rutaEnCadena(i, grado, profundidad); });
+    }
+
+    std::ofstream archivo(configuracion.archivoCsv);
+    if (!archivo.is_open()) {
+        std::cerr << "Error al crear el archivo de resultados" << std::endl;
+    } else {
+        archivo << "Eje,Nodos,Grado,Profundidad,Semilla,Altura,ProfundidadMedia,Bytes,Carga(ms),Busqueda(ns),Insercion(ns),Eliminacion(ns)" << std::endl;
+        for (const MuestraBarrido& m : muestras) {
+            archivo << m.eje << "," << m.nodos << "," << m.grado << "," << m.profundidad << "," << m.semilla << ","
+                    << m.altura << "," << std::fixed << std::setprecision(2) << m.profundidadMedia << "," << m.bytes << ","
+                    << std::setprecision(3) << m.cargaMs << "," << std::setprecision(2) << m.buscarNs << ","
+                    << m.insertarNs << "," << m.eliminarNs << std::endl;
+        }
+        std::cout << "Resultados guardados en: " << configuracion.archivoCsv << std::endl;
+    }
+
+    long long cacheUltimoNivel = tamanoCacheUltimoNivel();
+    for (const char* eje : {"nodos", "grado", "profundidad"}) {
+        resumirEje(eje, muestras, cacheUltimoNivel);
+    }
+}
+
+// Función para medir el árbol paginado a medida que el pool baja del 100% al 5% de las páginas
+void medirArbolPaginado(long long numNodos, int grado, const std::string& rutaArchivo) {
+    const int operaciones = REP / 5;  // Con pools chicos cada operación puede costar varias lecturas
+    const int mutaciones = REP / 20;
+    const std::vector<double> fracciones = {1.0, 0.5, 0.25, 0.1, 0.05};
+    auto nanosegundos = [](auto inicio, auto fin) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count());
+    };
+
+    // El árbol en memoria sirve de referencia para comprobar las respuestas del paginado
+    ArbolSistemaArchivos memoria;
+    generarArbolSintetico(memoria, numNodos, grado);
+
+    ArbolPaginado paginado(rutaArchivo, static_cast<size_t>(std::max(1024LL, numNodos / 16)));
+    if (!paginado.abierto()) return;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    for (long long i = 1; i < numNodos; ++i) {
+        paginado.insertarRuta(rutaSintetica(i, grado));
+    }
+    paginado.vaciar();
+    auto fin = std::chrono::high_resolution_clock::now();
+    long long paginas = paginado.obtenerNumeroPaginas();
+
+    std::cout << "\n=== ÁRBOL PAGINADO EN DISCO (" << numNodos << " nodos, grado " << grado << ") ===" << std::endl;
+    std::cout << "Archivo: " << rutaArchivo << " (" << (paginado.usaEntradaSalidaDirecta() ? "O_DIRECT" : "con caché del kernel")
+              << "), " << paginas << " páginas de " << PoolPaginas::TAMANO_PAGINA << " bytes = "
+              << std::fixed << std::setprecision(1)
+              << static_cast<double>(paginas) * PoolPaginas::TAMANO_PAGINA / (1024.0 * 1024.0) << " MiB" << std::endl;
+    std::cout << "Construcción: " << std::setprecision(3) << nanosegundos(inicio, fin) / 1e6 << " ms" << std::endl;
+    std::cout << "Memoria del árbol equivalente en RAM: " << std::setprecision(1)
+              << static_cast<double>(memoria.estadisticasMemoria().total()) / (1024.0 * 1024.0) << " MiB" << std::endl;
+
+    std::cout << std::left << std::setw(10) << "Pool (%)"
+              << std::setw(9) << "Marcos"
+              << std::setw(14) << "Buscar (ns)"
+              << std::setw(11) << "Lect/op"
+              << std::setw(14) << "Aciertos (%)"
+              << std::setw(15) << "Insertar (ns)"
+              << std::setw(15) << "Eliminar (ns)"
+              << std::setw(11) << "E/S/mut"
+              << std::setw(10) << "Correcto" << std::endl;
+    std::cout << std::string(109, '-') << std::endl;
+
+    std::mt19937_64 gen(11);
+    std::uniform_int_distribution<long long> distNodo(1, numNodos - 1);
+    for (double fraccion : fracciones) {
+        // Consultas: la mitad existen y la otra mitad no (nombre alterado)
+        std::vector<std::string> consultas;
+        for (int i = 0; i < operaciones; ++i) {
+            consultas.push_back(rutaSintetica(distNodo(gen), grado) + (i % 2 ? "" : "x"));
+        }
+        std::vector<std::string> nuevas;
+        for (int i = 0; i < mutaciones; ++i) {
+            long long padre = (distNodo(gen) - 1) / grado;
+            std::string rutaPadre = rutaSintetica(padre, grado);
+            nuevas.push_back((rutaPadre.empty() ? "" : rutaPadre + "/") + "paginado_" + std::to_string(i));
+        }
+
+        size_t marcos = static_cast<size_t>(std::ceil(fraccion * static_cast<double>(paginas)));
+        paginado.cambiarCapacidad(marcos);
+        for (int i = 0; i < operaciones / 10; ++i) {
+            paginado.buscar(consultas[static_cast<size_t>(i)]); // Calentamiento
+        }
+
+        const PoolPaginas& pool = paginado.obtenerPool();
+        paginado.reiniciarContadores();
+        inicio = std::chrono::high_resolution_clock::now();
+        for (const std::string& consulta : consultas) {
+            paginado.buscar(consulta);
+        }
+        fin = std::chrono::high_resolution_clock::now();
+        double buscarNs = nanosegundos(inicio, fin) / operaciones;
+        double lecturasPorOperacion = static_cast<double>(pool.obtenerLecturas()) / operaciones;
+        double aciertos = 100.0 * static_cast<double>(pool.obtenerAciertos()) /
+                          static_cast<double>(pool.obtenerAciertos() + pool.obtenerLecturas());
+
+        // Mutaciones: las escrituras diferidas se cuentan al vaciar el pool al final de cada fase
+        paginado.reiniciarContadores();
+        inicio = std::chrono::high_resolution_clock::now();
+        for (const std::string& nueva : nuevas) {
+            paginado.insertar(nueva);
+        }
+        paginado.vaciar();
+        fin = std::chrono::high_resolution_clock::now();
+        double insertarNs = nanosegundos(inicio, fin) / mutaciones;
+
+        std::shuffle(nuevas.begin(), nuevas.end(), gen);
+        inicio = std::chrono::high_resolution_clock::now();
+        for (const std::string& nueva : nuevas) {
+            paginado.eliminar(nueva);
+        }
+        paginado.vaciar();
+        fin = std::chrono::high_resolution_clock::now();
+        double eliminarNs = nanosegundos(inicio, fin) / mutaciones;
+        double entradaSalidaPorMutacion = static_cast<double>(pool.obtenerLecturas() + pool.obtenerEscrituras()) /
+                                          (2.0 * mutaciones);
+
+        // Comprobación: mismas respuestas que el árbol en memoria, incluso tras insertar y eliminar
+        bool correcto = paginado.obtenerNumeroNodos() == memoria.obtenerNumeroNodos();
+        for (int i = 0; i < operaciones / 10 && correcto; ++i) {
+            const std::string& consulta = consultas[static_cast<size_t>(i)];
+            correcto = paginado.buscar(consulta) == memoria.buscar(consulta);
+        }
+        for (int i = 0; i < mutaciones / 10 && correcto; ++i) {
+            const std::string& nueva = nuevas[static_cast<size_t>(i)];
+            correcto = paginado.insertar(nueva) == memoria.insertar(nueva) &&
+                       paginado.buscar(nueva) == memoria.buscar(nueva) &&
+                       paginado.eliminar(nueva) == memoria.eliminar(nueva);
+        }
+
+        std::cout << std::left << std::setw(10) << std::setprecision(0) << fraccion * 100.0
+                  << std::setw(9) << pool.capacidad()
+                  << std::setw(14) << std::setprecision(1) << buscarNs
+                  << std::setw(11) << std::setprecision(3) << lecturasPorOperacion
+                  << std::setw(14) << std::setprecision(2) << aciertos
+                  << std::setw(15) << std::setprecision(1) << insertarNs
+                  << std::setw(15) << eliminarNs
+                  << std::setw(11) << std::setprecision(2) << entradaSalidaPorMutacion
+                  << std::setw(10) << (correcto ? "sí" : "NO") << std::endl;
+    }
+
+    std::cout << std::string(109, '-') << std::endl;
+    if (!paginado.vaciar()) {
+        std::cout << "El árbol paginado se detuvo por un error de E/S" << std::endl;
+        return;
+    }
+
+    // Reapertura: la cabecera que deja vaciar() basta para retomar el archivo con un pool frío
+    ArbolPaginado reabierto(rutaArchivo, 64, paginado.usaEntradaSalidaDirecta(), AperturaPaginado::Abrir);
+    bool reabre = reabierto.abierto() && reabierto.obtenerNumeroNodos() == memoria.obtenerNumeroNodos();
+    for (int i = 0; i < operaciones / 10 && reabre; ++i) {
+        std::string consulta = rutaSintetica(distNodo(gen), grado);
+        reabre = reabierto.buscar(consulta) == memoria.buscar(consulta);
+    }
+    std::cout << "Reapertura desde la cabecera: " << (reabre ? "sí" : "NO") << std::endl;
+}
+
+// Función para medir cuánto ahorra el filtro negativo en buscar según la proporción de fallos
+void compararFiltroNegativo(const std::string& rutaDatos) {
+    const std::vector<double> proporciones = {0.0, 0.25, 0.5, 0.75, 0.9, 1.0};
+
+    ArbolSistemaArchivos arbol;
+    arbol.cargarDatos(rutaDatos);
+    std::vector<std::string> todasLasRutas = arbol.obtenerTodasLasRutas();
+    std::vector<std::string> todosLosDirectorios = arbol.obtenerTodosLosDirectorios();
+    todasLasRutas.insert(todasLasRutas.end(), todosLosDirectorios.begin(), todosLosDirectorios.end());
+    if (todasLasRutas.empty()) {
+        std::cout << "El directorio está vacío." << std::endl;
+        return;
+    }
+
+    std::cout << "\n=== FILTRO NEGATIVO EN BUSCAR (" << arbol.obtenerNumeroNodos() << " nodos, "
+              << REP << " búsquedas por medición) ===" << std::endl;
+    std::cout << std::left << std::setw(12) << "Fallos (%)"
+              << std::setw(18) << "Sin filtro (ns)"
+              << std::setw(18) << "Con filtro (ns)"
+              << std::setw(12) << "Aceleración" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    for (double proporcion : proporciones) {
+        arbol.desactivarFiltroNegativo();
+        double sinFiltro = medirTiempoBusqueda(arbol, todasLasRutas, proporcion);
+        arbol.activarFiltroNegativo();
+        double conFiltro = medirTiempoBusqueda(arbol, todasLasRutas, proporcion);
+
+        std::cout << std::left << std::setw(12) << std::fixed << std::setprecision(0) << proporcion * 100.0
+                  << std::setw(18) << std::setprecision(2) << sinFiltro
+                  << std::setw(18) << conFiltro
+                  << std::setw(12) << (conFiltro > 0.0 ? sinFiltro / conFiltro : 0.0) << std::endl;
+    }
+    std::cout << std::string(60, '-') << std::endl;
+
+    // Falsos positivos: rutas que no existen y que el filtro igual deja pasar
+    const FiltroCuckoo* filtro = arbol.obtenerFiltroNegativo();
+    long long positivos = 0;
+    for (int i = 0; i < REP; ++i) {
+        const std::string& ruta = todasLasRutas[static_cast<size_t>(i) % todasLasRutas.size()];
+        if (filtro->contiene(ArbolSistemaArchivos::hashRuta(ruta + "~" + std::to_string(i)))) positivos++;
+    }
+
+    // Mantenimiento: insertar y eliminar con el filtro activo deben dejarlo sin falsos negativos
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<size_t> distDir(0, std::max<size_t>(1, todosLosDirectorios.size()) - 1);
+    std::vector<std::string> nuevas;
+    for (int i = 0; i < NUM_DIRECTORIOS_INSERCION && !todosLosDirectorios.empty(); ++i) {
+        nuevas.push_back(todosLosDirectorios[distDir(gen)] + "/filtro_" + std::to_string(i));
+        arbol.insertar(nuevas.back());
+    }
+    for (size_t i = 0; i < nuevas.size(); i += 2) {
+        arbol.eliminar(nuevas[i]);
+    }
+    bool sinFalsosNegativos = true;
+    for (size_t i = 0; i < nuevas.size(); ++i) {
+        sinFalsosNegativos = sinFalsosNegativos && arbol.buscar(nuevas[i]) == (i % 2 ? 0 : 1);
+    }
+    for (const std::string& ruta : todasLasRutas) {
+        sinFalsosNegativos = sinFalsosNegativos && arbol.buscar(ruta) != 1;
+    }
+
+    filtro = arbol.obtenerFiltroNegativo(); // Las inserciones pudieron reconstruirlo
+    std::cout << "Memoria del filtro: " << filtro->bytesMemoria() << " bytes ("
+              << std::setprecision(2) << static_cast<double>(filtro->bytesMemoria() * 8) / static_cast<double>(filtro->obtenerElementos())
+              << " bits por ruta, ocupación " << filtro->ocupacion() * 100.0 << "%)" << std::endl;
+    std::cout << "Tasa de falsos positivos medida: " << std::setprecision(4)
+              << 100.0 * static_cast<double>(positivos) / REP << "% (" << positivos << " de " << REP << ")" << std::endl;
+    std::cout << "Sin falsos negativos tras insertar/eliminar: " << (sinFalsosNegativos ? "sí" : "NO") << std::endl;
+}
+
+namespace {
+
+const size_t MAYORES_DIRECTORIOS = 5;
+
+// Analítica de ejemplo sobre visitarParalelo: extensiones, directorios más grandes y nombres inválidos
+struct AnaliticaArbol {
+    std::map<std::string, long long, std::less<>> extensiones;
+    std::vector<std::pair<const NodoArbol*, std::string>> mayores; // Ordenados por grado descendente
+    long long nombresInvalidos;
+
+    AnaliticaArbol() : nombresInvalidos(0) {}
+};
+
+// Orden de los directorios más grandes: grado descendente y, ante empates, dirección (estable en un árbol)
+bool antesEnRanking(const NodoArbol* a, const NodoArbol* b) {
+    return a->hijos.size() != b->hijos.size() ? a->hijos.size() > b->hijos.size() : a < b;
+}
+
+// Función de mapeo: solo arma la ruta de los directorios que entran al ranking
+void mapearAnalitica(AnaliticaArbol& analitica, const NodoArbol& nodo, const ContextoVisita& contexto) {
+    if (contexto.profundidad() == 0) return; // La raíz no es una entrada real
+
+    const std::string& nombre = nodo.nombre;
+    if (nombre.empty() || nombre == "." || nombre == ".." || nombre.size() > 255 ||
+        nombre.find_first_of(std::string_view("/\\\0", 3)) != std::string::npos) {
+        analitica.nombresInvalidos++;
+    }
+
+    if (nodo.hijos.empty()) {
+        size_t punto = nombre.find_last_of('.');
+        std::string_view extension = punto == std::string::npos || punto == 0
+            ? std::string_view("(sin extensión)") : std::string_view(nombre).substr(punto);
+        auto it = analitica.extensiones.find(extension);
+        if (it == analitica.extensiones.end()) {
+            analitica.extensiones.emplace(std::string(extension), 1);
+        } else {
+            it->second++;
+        }
+        return;
+    }
+
+    auto& mayores = analitica.mayores;
+    if (mayores.size() == MAYORES_DIRECTORIOS && !antesEnRanking(&nodo, mayores.back().first)) return;
+    std::string ruta;
+    contexto.escribirRuta(ruta);
+    auto posicion = std::find_if(mayores.begin(), mayores.end(),
+                                 [&](const auto& candidato) { return antesEnRanking(&nodo, candidato.first); });
+    mayores.insert(posicion, {&nodo, std::move(ruta)});
+    if (mayores.size() > MAYORES_DIRECTORIOS) mayores.pop_back();
+}
+
+// Función de reducción: suma extensiones e inválidos y mezcla los rankings
+void reducirAnalitica(AnaliticaArbol& destino, const AnaliticaArbol& parcial) {
+    for (const auto& [extension, cantidad] : parcial.extensiones) {
+        destino.extensiones[extension] += cantidad;
+    }
+    destino.nombresInvalidos += parcial.nombresInvalidos;
+
+    std::vector<std::pair<const NodoArbol*, std::string>> mezcla;
+    std::merge(destino.mayores.begin(), destino.mayores.end(), parcial.mayores.begin(), parcial.mayores.end(),
+               std::back_inserter(mezcla),
+               [](const auto& a, const auto& b) { return antesEnRanking(a.first, b.first); });
+    if (mezcla.size() > MAYORES_DIRECTORIOS) mezcla.resize(MAYORES_DIRECTORIOS);
+    destino.mayores = std::move(mezcla);
+}
+
+bool mismaAnalitica(const AnaliticaArbol& a, const AnaliticaArbol& b) {
+    return a.extensiones == b.extensiones && a.nombresInvalidos == b.nombresInvalidos && a.mayores == b.mayores;
+}
+
+// Conteo recursivo clásico: referencia para el costo de visitarParalelo con un solo hilo
+long long contarRecursivo(const NodoArbol* nodo) {
+    long long contador = 1;
+    for (const NodoArbol* hijo : nodo->hijos) {
+        contador += contarRecursivo(hijo);
+    }
+    return contador;
+}
+
+} // namespace
+
+// Función para medir la escalabilidad de visitarParalelo con distinto número de hilos.
+// Se usan dos formas: un árbol k-ario completo y uno desbalanceado, con el 90% de los nodos
+// bajo un único hijo de la raíz (un reparto fijo por hijo de la raíz no escalaría ahí)
+void medirVisitaParalela(long long numNodos, int grado, unsigned hilosMax) {
+    const int repeticiones = 3;
+    auto milisegundos = [](auto inicio, auto fin) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()) / 1000.0;
+    };
+    if (hilosMax == 0) hilosMax = std::max(8u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> cantidadesHilos;
+    for (unsigned hilos = 1; hilos < hilosMax; hilos *= 2) {
+        cantidadesHilos.push_back(hilos);
+    }
+    cantidadesHilos.push_back(hilosMax);
+
+    std::cout << "\n=== VISITA PARALELA (" << numNodos << " nodos, grado " << grado << ", "
+              << std::thread::hardware_concurrency() << " núcleos disponibles) ===" << std::endl;
+
+    for (int forma = 0; forma < 2; ++forma) {
+        ArbolSistemaArchivos arbol;
+        if (forma == 0) {
+            generarArbolSintetico(arbol, numNodos, grado);
+        } else {
+            long long pesados = numNodos * 9 / 10;
+            arbol.insertarRuta("");
+            for (long long i = 1; i < pesados; ++i) {
+                arbol.insertarRuta("pesado/" + rutaSintetica(i, grado));
+            }
+            for (long long i = pesados; i < numNodos; ++i) {
+                arbol.insertarRuta("liviano/" + std::to_string(i) + "_" +
+                                   NOMBRES_ARCHIVOS[static_cast<size_t>(i) % NOMBRES_ARCHIVOS.size()]);
+            }
+        }
+        const NodoArbol* raiz = arbol.obtenerRaiz();
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        long long nodosRecursivo = contarRecursivo(raiz);
+        auto fin = std::chrono::high_resolution_clock::now();
+        std::cout << "\nForma: " << (forma == 0 ? "completa" : "desbalanceada (90% en un subárbol)")
+                  << ", " << nodosRecursivo << " nodos. Conteo recursivo secuencial: "
+                  << std::fixed << std::setprecision(2) << milisegundos(inicio, fin) << " ms" << std::endl;
+        std::cout << std::left << std::setw(7) << "Hilos"
+                  << std::setw(13) << "Contar (ms)"
+                  << std::setw(13) << "Altura (ms)"
+                  << std::setw(16) << "Analítica (ms)"
+                  << std::setw(13) << "Aceleración"
+                  << std::setw(10) << "Correcto" << std::endl;
+        std::cout << std::string(72, '-') << std::endl;
+
+        AnaliticaArbol referencia;
+        int alturaReferencia = 0;
+        double analiticaUnHilo = 0.0;
+        for (unsigned hilos : cantidadesHilos) {
+            double contarMs = 1e18, alturaMs = 1e18, analiticaMs = 1e18;
+            long long nodos = 0;
+            int altura = 0;
+            AnaliticaArbol analitica;
+            for (int r = 0; r < repeticiones; ++r) {
+                inicio = std::chrono::high_resolution_clock::now();
+                nodos = visitarParalelo(raiz, 0LL,
+                    [](long long& contador, const NodoArbol&, const ContextoVisita&) { contador++; },
+                    [](long long& contador, long long otro) { contador += otro; }, hilos);
+                fin = std::chrono::high_resolution_clock::now();
+                contarMs = std::min(contarMs, milisegundos(inicio, fin));
+
+                inicio = std::chrono::high_resolution_clock::now();
+                altura = visitarParalelo(raiz, 0,
+                    [](int& maximo, const NodoArbol&, const ContextoVisita& contexto) {
+                        maximo = std::max(maximo, contexto.profundidad() + 1);
+                    },
+                    [](int& maximo, int otro) { maximo = std::max(maximo, otro); }, hilos);
+                fin = std::chrono::high_resolution_clock::now();
+                alturaMs = std::min(alturaMs, milisegundos(inicio, fin));
+
+                inicio = std::chrono::high_resolution_clock::now();
+                analitica = visitarParalelo(raiz, AnaliticaArbol(), mapearAnalitica, reducirAnalitica, hilos);
+                fin = std::chrono::high_resolution_clock::now();
+                analiticaMs = std::min(analiticaMs, milisegundos(inicio, fin));
+            }
+
+            if (hilos == 1) {
+                referencia = analitica;
+                alturaReferencia = altura;
+                analiticaUnHilo = analiticaMs;
+            }
+            bool correcto = nodos == nodosRecursivo && altura == alturaReferencia && mismaAnalitica(analitica, referencia);
+
+            std::cout << std::left << std::setw(7) << hilos
+                      << std::setw(13) << std::setprecision(2) << contarMs
+                      << std::setw(13) << alturaMs
+                      << std::setw(16) << analiticaMs
+                      << std::setw(13) << analiticaUnHilo / std::max(analiticaMs, 0.001)
+                      << std::setw(10) << (correcto ? "sí" : "NO") << std::endl;
+        }
+
+        std::cout << "Altura: " << alturaReferencia << ", nombres inválidos: " << referencia.nombresInvalidos
+                  << ", extensiones distintas: " << referencia.extensiones.size() << std::endl;
+        std::cout << "Directorios más grandes:" << std::endl;
+        for (const auto& [nodo, ruta] : referencia.mayores) {
+            std::cout << "  " << nodo->hijos.size() << "\t" << (ruta.empty() ? "/" : ruta) << std::endl;
+        }
+    }
+}
+
+// Función para comparar operaciones relativas a un manejador de directorio contra rutas completas.
+// Se insertan y buscan 'numArchivos' archivos bajo el directorio más profundo de una cadena
+// (rutaEnCadena, grado 16) para profundidades crecientes: con rutas completas cada operación
+// tokeniza y baja por todo el camino, con el manejador solo por el nombre del archivo
+void medirManejadoresDirectorio(int numArchivos, int profundidadMaxima) {
+    const int grado = 16;
+    const int cadenas = 4;
+    const int rondasBusqueda = 5;
+    auto nanosegundos = [](auto inicio, auto fin, long long operaciones) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count()) /
+               static_cast<double>(std::max(1LL, operaciones));
+    };
+
+    std::vector<int> profundidades;
+    for (int profundidad = 1; profundidad < profundidadMaxima; profundidad *= 4) {
+        profundidades.push_back(profundidad);
+    }
+    profundidades.push_back(std::max(1, profundidadMaxima));
+
+    std::cout << "\n=== MANEJADORES DE DIRECTORIO (" << numArchivos << " archivos en un directorio, "
+              << rondasBusqueda << " rondas de búsqueda con 50% de fallos) ===" << std::endl;
+    std::cout << std::left << std::setw(13) << "Profundidad"
+              << std::setw(17) << "Ins. ruta (ns)"
+              << std::setw(19) << "Ins. manej. (ns)"
+              << std::setw(18) << "Busc. ruta (ns)"
+              << std::setw(20) << "Busc. manej. (ns)"
+              << std::setw(13) << "Aceleración"
+              << std::setw(10) << "Correcto" << std::endl;
+    std::cout << std::string(110, '-') << std::endl;
+
+    std::vector<std::string> nombres, ausentes;
+    for (int i = 0; i < numArchivos; ++i) {
+        nombres.push_back(std::to_string(i) + "_" + NOMBRES_ARCHIVOS[static_cast<size_t>(i) % NOMBRES_ARCHIVOS.size()]);
+        ausentes.push_back(nombres.back() + ".bak");
+    }
+
+    for (int profundidad : profundidades) {
+        ArbolSistemaArchivos base;
+        long long nodosBase = static_cast<long long>(grado) * profundidad * cadenas;
+        for (long long i = 0; i < nodosBase; ++i) {
+            base.insertarRuta(rutaEnCadena(i, grado, profundidad));
+        }
+        std::string directorio = rutaEnCadena(static_cast<long long>(grado) * (profundidad - 1), grado, profundidad);
+
+        // Los llamadores con rutas completas ya las tienen armadas: no se mide concatenarlas
+        std::vector<std::string> rutas, rutasAusentes;
+        for (int i = 0; i < numArchivos; ++i) {
+            rutas.push_back(directorio + "/" + nombres[static_cast<size_t>(i)]);
+            rutasAusentes.push_back(directorio + "/" + ausentes[static_cast<size_t>(i)]);
+        }
+
+        ArbolSistemaArchivos porRuta(base);
+        auto inicio = std::chrono::high_resolution_clock::now();
+        bool correcto = true;
+        for (const std::string& ruta : rutas) {
+            correcto = porRuta.insertar(ruta) == 0 && correcto;
+        }
+        auto fin = std::chrono::high_resolution_clock::now();
+        double insertarRuta = nanosegundos(inicio, fin, numArchivos);
+
+        ArbolSistemaArchivos porManejador(base);
+        ManejadorDirectorio manejador = porManejador.abrirDirectorio(directorio);
+        inicio = std::chrono::high_resolution_clock::now();
+        for (const std::string& nombre : nombres) {
+            correcto = porManejador.insertarEn(manejador, nombre) == 0 && correcto;
+        }
+        fin = std::chrono::high_resolution_clock::now();
+        double insertarManejador = nanosegundos(inicio, fin, numArchivos);
+
+        long long encontradosRuta = 0, encontradosManejador = 0;
+        inicio = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rondasBusqueda; ++r) {
+            for (int i = 0; i < numArchivos; ++i) {
+                encontradosRuta += porRuta.buscar(rutas[static_cast<size_t>(i)]) != 1;
+                encontradosRuta += porRuta.buscar(rutasAusentes[static_cast<size_t>(i)]) != 1;
+            }
+        }
+        fin = std::chrono::high_resolution_clock::now();
+        long long busquedas = 2LL * rondasBusqueda * numArchivos;
+        double buscarRuta = nanosegundos(inicio, fin, busquedas);
+
+        inicio = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rondasBusqueda; ++r) {
+            for (int i = 0; i < numArchivos; ++i) {
+                encontradosManejador += porManejador.buscarEn(manejador, nombres[static_cast<size_t>(i)]) != 1;
+                encontradosManejador += porManejador.buscarEn(manejador, ausentes[static_cast<size_t>(i)]) != 1;
+            }
+        }
+        fin = std::chrono::high_resolution_clock::now();
+        double buscarManejador = nanosegundos(inicio, fin, busquedas);
+
+        correcto = correcto && encontradosRuta == static_cast<long long>(rondasBusqueda) * numArchivos &&
+                   encontradosManejador == encontradosRuta && porRuta.hashArbol() == porManejador.hashArbol();
+        porManejador.cerrarDirectorio(manejador);
+
+        std::cout << std::left << std::setw(13) << profundidad
+                  << std::setw(17) << std::fixed << std::setprecision(1) << insertarRuta
+                  << std::setw(19) << insertarManejador
+                  << std::setw(18) << buscarRuta
+                  << std::setw(20) << buscarManejador
+                  << std::setw(13) << std::setprecision(2) << buscarRuta / std::max(buscarManejador, 0.001)
+                  << std::setw(10) << (correcto ? "sí" : "NO") << std::endl;
+    }
+    std::cout << std::string(110, '-') << std::endl;
+}
@@ -0,0 +1,104 @@
+#include "filtro_cuckoo.h"
+#include <algorithm>
+#include <bit>
+
+// Constructor: dimensiona para 'capacidad' claves a un 85% de ocupación (más allá las
+// inserciones empiezan a necesitar cadenas de desplazamientos largas)
+FiltroCuckoo::FiltroCuckoo(long long capacidad) : mascara(0), elementos(0), estadoAleatorio(0x9E3779B97F4A7C15ull) {
+    std::uint64_t necesarias = static_cast<std::uint64_t>(std::max(1LL, capacidad)) * 100 / (85 * HUELLAS_POR_CUBETA) + 1;
+    std::uint64_t cubetas = std::bit_ceil(necesarias);
+    huellas.assign(cubetas * HUELLAS_POR_CUBETA, 0);
+    mascara = cubetas - 1;
+}
+
+// Huella de 16 bits tomada de los bits altos (los bajos eligen la cubeta); nunca 0
+std::uint16_t FiltroCuckoo::huella(std::uint64_t hash) {
+    std::uint16_t resultado = static_cast<std::uint16_t>(hash >> 48);
+    return resultado ? resultado : 1;
+}
+
+// Cubeta alternativa: depende solo de la cubeta actual y la huella, y aplicarla dos veces vuelve al inicio
+std::uint64_t FiltroCuckoo::alternativa(std::uint64_t cubeta, std::uint16_t huellaClave) const {
+    return (cubeta ^ (static_cast<std::uint64_t>(huellaClave) * 0xC6A4A7935BD1E995ull)) & mascara;
+}
+
+bool FiltroCuckoo::colocar(std::uint64_t cubeta, std::uint16_t huellaClave) {
+    std::uint16_t* posiciones = &huellas[cubeta * HUELLAS_POR_CUBETA];
+    for (int i = 0; i < HUELLAS_POR_CUBETA; ++i) {
+        if (posiciones[i] == 0) {
+            posiciones[i] = huellaClave;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FiltroCuckoo::contieneEn(std::uint64_t cubeta, std::uint16_t huellaClave) const {
+    const std::uint16_t* posiciones = &huellas[cubeta * HUELLAS_POR_CUBETA];
+    return (posiciones[0] == huellaClave) | (posiciones[1] == huellaClave) |
+           (posiciones[2] == huellaClave) | (posiciones[3] == huellaClave);
+}
+
+// Función para insertar una clave. Retorna false si el filtro se llenó: en ese caso quedó fuera
+// alguna huella y el filtro debe reconstruirse más grande antes de volver a consultarlo
+bool FiltroCuckoo::insertar(std::uint64_t hash) {
+    std::uint16_t huellaClave = huella(hash);
+    std::uint64_t cubeta = hash & mascara;
+    std::uint64_t otra = alternativa(cubeta, huellaClave);
+    if (colocar(cubeta, huellaClave) || colocar(otra, huellaClave)) {
+        elementos++;
+        return true;
+    }
+
+    // Ambas llenas: desalojar huellas al azar hacia su cubeta alternativa
+    for (int i = 0; i < MAX_DESPLAZAMIENTOS; ++i) {
+        estadoAleatorio ^= estadoAleatorio << 13;
+        estadoAleatorio ^= estadoAleatorio >> 7;
+        estadoAleatorio ^= estadoAleatorio << 17;
+        if (i == 0 && (estadoAleatorio & 4)) cubeta = otra;
+
+        std::swap(huellaClave, huellas[cubeta * HUELLAS_POR_CUBETA + (estadoAleatorio & 3)]);
+        cubeta = alternativa(cubeta, huellaClave);
+        if (colocar(cubeta, huellaClave)) {
+            elementos++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Función de consulta: false garantiza que la clave no fue insertada
+bool FiltroCuckoo::contiene(std::uint64_t hash) const {
+    std::uint16_t huellaClave = huella(hash);
+    std::uint64_t cubeta = hash & mascara;
+    return contieneEn(cubeta, huellaClave) || contieneEn(alternativa(cubeta, huellaClave), huellaClave);
+}
+
+// Función para eliminar una clave insertada antes (borrar una que no lo fue puede crear falsos negativos)
+bool FiltroCuckoo::eliminar(std::uint64_t hash) {
+    std::uint16_t huellaClave = huella(hash);
+    std::uint64_t cubeta = hash & mascara;
+    for (std::uint64_t candidata : {cubeta, alternativa(cubeta, huellaClave)}) {
+        std::uint16_t* posiciones = &huellas[candidata * HUELLAS_POR_CUBETA];
+        for (int i = 0; i < HUELLAS_POR_CUBETA; ++i) {
+            if (posiciones[i] == huellaClave) {
+                posiciones[i] = 0;
+                elementos--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+long long FiltroCuckoo::obtenerElementos() const {
+    return elementos;
+}
+
+long long FiltroCuckoo::bytesMemoria() const {
+    return static_cast<long long>(huellas.size() * sizeof(std::uint16_t));
+}
+
+double FiltroCuckoo::ocupacion() const {
+    return static_cast<double>(elementos) / static_cast<double>(huellas.size());
+}
@@ -0,0 +1,120 @@
+#include "indice_hijos.h"
+#include <bit>
+
+namespace {
+
+// Búsquedas tras un cambio, por cada hijo, antes de reconstruir: el costo O(n) de reconstruir
+// queda repartido en al menos n/4 búsquedas
+const size_t DIVISOR_RECONSTRUCCION = 4;
+
+// Claves de 16 bytes: una línea de caché trae 4, así que precargar k*4 adelanta 2 niveles
+const size_t ADELANTO_PRECARGA = 4;
+
+// Lee 8 bytes del nombre desde 'desde' en big-endian, rellenando con ceros
+std::uint64_t leerBigEndian(const std::string& nombre, size_t desde) {
+    std::uint64_t resultado = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        unsigned char byte = desde + i < nombre.size() ? static_cast<unsigned char>(nombre[desde + i]) : 0;
+        resultado = (resultado << 8) | byte;
+    }
+    return resultado;
+}
+
+} // namespace
+
+// Constructor: el índice nace inválido y se construye al acumular búsquedas
+IndiceHijos::IndiceHijos() : prefijoComun(0), busquedasPendientes(0), valido(false) {}
+
+// Función para calcular la clave de orden: 16 bytes del nombre desde 'desde', en big-endian y
+// rellenos con ceros (los nombres no contienen bytes nulos)
+ClaveNombre IndiceHijos::clave(const std::string& nombre, size_t desde) {
+    return {leerBigEndian(nombre, desde), leerBigEndian(nombre, desde + 8)};
+}
+
+// Función para marcar el índice como desactualizado tras insertar o eliminar un hijo
+void IndiceHijos::invalidar() {
+    valido = false;
+    busquedasPendientes = 0;
+}
+
+// Función para saber si el índice puede usarse; lo reconstruye si ya se amortizó
+bool IndiceHijos::preparar(const std::vector<NodoArbol*>& hijos) {
+    if (valido) return true;
+    if (++busquedasPendientes < hijos.size() / DIVISOR_RECONSTRUCCION) return false;
+    construir(hijos);
+    return true;
+}
+
+// Función para reconstruir el índice desde los hijos ordenados
+void IndiceHijos::construir(const std::vector<NodoArbol*>& hijos) {
+    size_t n = hijos.size();
+    const std::string& primero = hijos.front()->nombre;
+    const std::string& ultimo = hijos.back()->nombre;
+    prefijoComun = 0;
+    while (prefijoComun < primero.size() && prefijoComun < ultimo.size() &&
+           primero[prefijoComun] == ultimo[prefijoComun]) {
+        prefijoComun++;
+    }
+
+    claves.assign(n + 1, ClaveNombre{0, 0});
+    posiciones.assign(n + 1, 0);
+
+    // Recorrido en orden del árbol implícito (hijos de k en 2k y 2k+1): asigna los hijos ordenados
+    std::vector<size_t> pila;
+    size_t siguiente = 0;
+    size_t k = 1;
+    while (k <= n || !pila.empty()) {
+        while (k <= n) {
+            pila.push_back(k);
+            k = 2 * k;
+        }
+        k = pila.back();
+        pila.pop_back();
+        claves[k] = clave(hijos[siguiente]->nombre, prefijoComun);
+        posiciones[k] = static_cast<std::uint32_t>(siguiente++);
+        k = 2 * k + 1;
+    }
+
+    valido = true;
+    busquedasPendientes = 0;
+}
+
+// Función para buscar un hijo por nombre (el índice debe estar preparado)
+NodoArbol* IndiceHijos::buscar(const std::vector<NodoArbol*>& hijos, const std::string& nombre) const {
+    // Todos los hijos comparten el prefijo común: si el nombre no lo tiene, no está
+    if (nombre.compare(0, prefijoComun, hijos.front()->nombre, 0, prefijoComun) != 0) {
+        return nullptr;
+    }
+
+    // Si el resto del nombre cabe en la clave (con al menos un byte de relleno), claves iguales
+    // implican nombres iguales y no hace falta mirar los nodos
+    ClaveNombre buscada = clave(nombre, prefijoComun);
+    bool claveCompleta = nombre.size() - prefijoComun < sizeof(ClaveNombre);
+    const ClaveNombre* datos = claves.data();
+    size_t n = claves.size() - 1;
+    size_t k = 1;
+    while (k <= n) {
+        // La dirección puede quedar fuera del arreglo: precargar no falla ni se desreferencia
+        __builtin_prefetch(reinterpret_cast<const void*>(
+            reinterpret_cast<std::uintptr_t>(datos) + k * ADELANTO_PRECARGA * sizeof(ClaveNombre)));
+        const ClaveNombre& actual = datos[k];
+        bool altaIgual = actual.alta == buscada.alta;
+        bool menor = (actual.alta < buscada.alta) | (altaIgual & (actual.baja < buscada.baja));
+        if (!claveCompleta && altaIgual && actual.baja == buscada.baja) [[unlikely]] {
+            menor = hijos[posiciones[k]]->nombre < nombre;
+        }
+        k = 2 * k + menor;
+    }
+
+    // Deshacer los giros a la derecha finales: queda el primer elemento >= nombre (0 si no hay)
+    k >>= std::countr_one(k) + 1;
+    if (k == 0 || datos[k].alta != buscada.alta || datos[k].baja != buscada.baja) return nullptr;
+    NodoArbol* candidato = hijos[posiciones[k]];
+    return claveCompleta || candidato->nombre == nombre ? candidato : nullptr;
+}
+
+// Función para obtener la memoria reservada por el índice
+long long IndiceHijos::bytesMemoria() const {
+    return static_cast<long long>(sizeof(IndiceHijos) + claves.capacity() * sizeof(ClaveNombre) +
+                                  posiciones.capacity() * sizeof(std::uint32_t));
+}
@@ -1,9 +1,11 @@
 #include "experimentacion.h"
+#include "servidor.h"
 #include "tree.h"
 #include <iostream>
 #include <string>
 #include <filesystem>
 #include <chrono>
+#include <sstream>
 
 void mostrarMenu() {
     std::cout << "\n=== SISTEMA DE ARCHIVOS CON ÁRBOL K-ARIO ===" << std::endl;
@@ -11,7 +13,16 @@ void mostrarMenu() {
     std::cout << "2. Crear árbol desde directorio personalizado" << std::endl;
     std::cout << "3. Pruebas básicas de funcionalidad" << std::endl;
     std::cout << "4. Limpiar directorios de prueba" << std::endl;
-    std::cout << "5. Salir" << std::endl;
+    std::cout << "5. Comparar carga con metadatos (io_uring vs síncrona)" << std::endl;
+    std::cout << "6. Inserción multihilo (bloqueo por subárbol vs cerrojo global)" << std::endl;
+    std::cout << "7. Diario de mutaciones y recuperación" << std::endl;
+    std::cout << "8. Diferencia y fusión entre árboles" << std::endl;
+    std::cout << "9. Barrido de complejidad (nodos, grado, profundidad)" << std::endl;
+    std::cout << "10. Árbol paginado en disco con pool acotado" << std::endl;
+    std::cout << "11. Filtro negativo en búsquedas fallidas" << std::endl;
+    std::cout << "12. Escalabilidad de la visita paralela" << std::endl;
+    std::cout << "13. Manejadores de directorio vs rutas completas" << std::endl;
+    std::cout << "14. Salir" << std::endl;
     std::cout << "Seleccione una opción: ";
 }
 
@@ -116,6 +127,10 @@ void crearArbolPersonalizado() {
     std::cout << "Archivos encontrados: " << archivos.size() << std::endl;
     std::cout << "Directorios encontrados: " << directorios.size() << std::endl;
     
+    // Huella de memoria y efecto de recortar la holgura
+    mostrarEstadisticasMemoria(arbol.estadisticasMemoria());
+    std::cout << "Bytes liberados por reducirMemoria(): " << arbol.reducirMemoria() << std::endl;
+    
     // Opción para mostrar algunos archivos
     char opcion;
     std::cout << "¿Desea ver algunos archivos? (s/n): ";
@@ -130,7 +145,78 @@ void crearArbolPersonalizado() {
     }
 }
 
-int main() {
+// Función para leer un valor numérico completo de la línea de comandos (sin restos como "10x")
+template <typename T>
+bool leerValorOpcion(const std::string& texto, T& valor) {
+    std::istringstream entrada(texto);
+    return entrada >> valor && (entrada >> std::ws).eof();
+}
+
+// Función para atender los modos no interactivos (servidor y cliente de carga); retorna -1 si no aplica
+int ejecutarModoLineaComandos(int argc, char* argv[]) {
+    if (argc < 3) return -1;
+    std::string modo = argv[1];
+
+    if (modo == "--servidor") {
+        ConfiguracionServidor configuracion;
+        configuracion.rutaDatos = argv[2];
+        for (int i = 3; i < argc; ++i) {
+            std::string opcion = argv[i];
+            if (opcion == "--socket" && i + 1 < argc) {
+                configuracion.rutaSocket = argv[++i];
+            } else if (opcion == "--sin-stdin") {
+                configuracion.usarEntradaEstandar = false;
+            } else {
+                std::cerr << "Opción desconocida: " << opcion << std::endl;
+                return 1;
+            }
+        }
+        return ejecutarServidor(configuracion);
+    }
+
+    if (modo == "--cliente") {
+        ConfiguracionCliente configuracion;
+        configuracion.rutaSocket = argv[2];
+        for (int i = 3; i < argc; i += 2) {
+            std::string opcion = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Falta el valor de la opción: " << opcion << std::endl;
+                return 1;
+            }
+            std::string valor = argv[i + 1];
+            bool valido;
+            if (opcion == "--conexiones") {
+                valido = leerValorOpcion(valor, configuracion.conexiones) && configuracion.conexiones > 0;
+            } else if (opcion == "--pipeline") {
+                valido = leerValorOpcion(valor, configuracion.profundidadPipeline) && configuracion.profundidadPipeline > 0;
+            } else if (opcion == "--peticiones") {
+                valido = leerValorOpcion(valor, configuracion.peticiones) && configuracion.peticiones > 0;
+            } else if (opcion == "--escrituras") {
+                // Es una fracción: 0 (solo búsquedas) también es válido
+                valido = leerValorOpcion(valor, configuracion.proporcionEscrituras) &&
+                         configuracion.proporcionEscrituras >= 0.0 && configuracion.proporcionEscrituras <= 1.0;
+            } else {
+                std::cerr << "Opción desconocida: " << opcion << std::endl;
+                return 1;
+            }
+            if (!valido) {
+                std::cerr << "Valor inválido para " << opcion << ": " << valor << std::endl;
+                return 1;
+            }
+        }
+        return ejecutarClienteCarga(configuracion);
+    }
+
+    return -1;
+}
+
+int main(int argc, char* argv[]) {
+    // Modos no interactivos:
+    //   file_experiments --servidor <ruta_datos> [--socket <ruta>] [--sin-stdin]
+    //   file_experiments --cliente <socket> [--conexiones N] [--pipeline P] [--peticiones T] [--escrituras f]
+    int codigo = ejecutarModoLineaComandos(argc, argv);
+    if (codigo >= 0) return codigo;
+
     std::cout << "Iniciando programa de experimentos con Árbol K-ario..." << std::endl;
     
     int opcion;
@@ -189,6 +275,185 @@ int main() {
             }
             
             case 5: {
+                std::cout << "\n=== CARGA CON METADATOS ===" << std::endl;
+                std::string rutaDatos;
+                std::cout << "Ingrese la ruta del directorio a cargar: ";
+                std::getline(std::cin, rutaDatos);
+                
+                if (!std::filesystem::is_directory(rutaDatos)) {
+                    std::cout << "Error: La ruta no es un directorio." << std::endl;
+                    break;
+                }
+                
+                unsigned profundidadCola = 256;
+                std::cout << "Profundidad de la cola io_uring (ej: 256): ";
+                std::string entrada;
+                std::getline(std::cin, entrada);
+                unsigned valor;
+                if (std::istringstream(entrada) >> valor && valor > 0) {
+                    profundidadCola = valor;
+                }
+                
+                compararCargaMetadatos(rutaDatos, profundidadCola);
+                break;
+            }
+            
+            case 6: {
+                std::cout << "\n=== INSERCIÓN MULTIHILO ===" << std::endl;
+                std::string rutaDatos;
+                std::cout << "Ingrese la ruta del directorio a cargar: ";
+                std::getline(std::cin, rutaDatos);
+                
+                if (!std::filesystem::is_directory(rutaDatos)) {
+                    std::cout << "Error: La ruta no es un directorio." << std::endl;
+                    break;
+                }
+                
+                ejecutarExperimentoConcurrente(rutaDatos);
+                break;
+            }
+            
+            case 7: {
+                std::cout << "\n=== DIARIO DE MUTACIONES ===" << std::endl;
+                std::string rutaDatos;
+                std::cout << "Ingrese la ruta del directorio a cargar: ";
+                std::getline(std::cin, rutaDatos);
+                
+                if (!std::filesystem::is_directory(rutaDatos)) {
+                    std::cout << "Error: La ruta no es un directorio." << std::endl;
+                    break;
+                }
+                
+                std::string directorioTrabajo;
+                std::cout << "Directorio para el diario y el punto de control (ej: /tmp): ";
+                std::getline(std::cin, directorioTrabajo);
+                if (directorioTrabajo.empty()) {
+                    directorioTrabajo = "/tmp";
+                }
+                
+                medirMutacionesConDiario(rutaDatos, directorioTrabajo);
+                break;
+            }
+            
+            case 8: {
+                std::cout << "\n=== DIFERENCIA Y FUSIÓN ===" << std::endl;
+                std::vector<long long> tamanos;
+                std::vector<double> tasas;
+                std::string entrada;
+                
+                std::cout << "Tamaños en nodos separados por espacio (ej: 1000000 10000000): ";
+                std::getline(std::cin, entrada);
+                std::istringstream flujoTamanos(entrada.empty() ? "1000000 10000000" : entrada);
+                for (long long tamano; flujoTamanos >> tamano;) {
+                    tamanos.push_back(tamano);
+                }
+                
+                std::cout << "Tasas de cambio separadas por espacio (ej: 0.0001 0.001 0.01): ";
+                std::getline(std::cin, entrada);
+                std::istringstream flujoTasas(entrada.empty() ? "0.0001 0.001 0.01" : entrada);
+                for (double tasa; flujoTasas >> tasa;) {
+                    tasas.push_back(tasa);
+                }
+                
+                medirDiferencia(tamanos, tasas);
+                break;
+            }
+            
+            case 9: {
+                std::cout << "\n=== BARRIDO DE COMPLEJIDAD ===" << std::endl;
+                ConfiguracionBarrido configuracion;
+                std::string entrada;
+                
+                std::cout << "Nodos mínimo, máximo y factor (ej: 1000 4096000 4): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> configuracion.nodosMin >> configuracion.nodosMax >> configuracion.factorNodos;
+                
+                std::cout << "Grado mínimo, máximo y factor (ej: 2 2048 4): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> configuracion.gradoMin >> configuracion.gradoMax >> configuracion.factorGrado;
+                
+                std::cout << "Profundidad mínima, máxima y factor (ej: 1 256 4): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> configuracion.profundidadMin >> configuracion.profundidadMax
+                                            >> configuracion.factorProfundidad;
+                
+                std::cout << "Nodos y grado fijos para los otros ejes (ej: 100000 16): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> configuracion.nodosFijos >> configuracion.gradoFijo;
+                
+                std::cout << "Semillas por punto (ej: 3): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> configuracion.semillas;
+                
+                ejecutarBarridoComplejidad(configuracion);
+                break;
+            }
+            
+            case 10: {
+                std::cout << "\n=== ÁRBOL PAGINADO ===" << std::endl;
+                long long numNodos = 1000000;
+                int grado = 16;
+                std::string entrada, rutaArchivo;
+                
+                std::cout << "Nodos y grado del árbol sintético (ej: 1000000 16): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> numNodos >> grado;
+                
+                std::cout << "Archivo de páginas (ej: /tmp/arbol_paginado.db): ";
+                std::getline(std::cin, rutaArchivo);
+                if (rutaArchivo.empty()) {
+                    rutaArchivo = "/tmp/arbol_paginado.db";
+                }
+                
+                medirArbolPaginado(numNodos, grado, rutaArchivo);
+                break;
+            }
+            
+            case 11: {
+                std::cout << "\n=== FILTRO NEGATIVO ===" << std::endl;
+                std::string rutaDatos;
+                std::cout << "Ingrese la ruta del directorio a cargar: ";
+                std::getline(std::cin, rutaDatos);
+                
+                if (!std::filesystem::exists(rutaDatos)) {
+                    std::cout << "Error: El directorio no existe." << std::endl;
+                    break;
+                }
+                
+                compararFiltroNegativo(rutaDatos);
+                break;
+            }
+            
+            case 12: {
+                std::cout << "\n=== VISITA PARALELA ===" << std::endl;
+                long long numNodos = 2000000;
+                int grado = 16;
+                unsigned hilosMax = 0;
+                std::string entrada;
+                
+                std::cout << "Nodos, grado y máximo de hilos (ej: 2000000 16 8; 0 hilos = automático): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> numNodos >> grado >> hilosMax;
+                
+                medirVisitaParalela(numNodos, grado, hilosMax);
+                break;
+            }
+            
+            case 13: {
+                std::cout << "\n=== MANEJADORES DE DIRECTORIO ===" << std::endl;
+                int numArchivos = 20000;
+                int profundidadMaxima = 64;
+                std::string entrada;
+                
+                std::cout << "Archivos y profundidad máxima del directorio (ej: 20000 64): ";
+                std::getline(std::cin, entrada);
+                std::istringstream(entrada) >> numArchivos >> profundidadMaxima;
+                
+                medirManejadoresDirectorio(numArchivos, profundidadMaxima);
+                break;
+            }
+            
+            case 14: {
                 std::cout << "Saliendo del programa..." << std::endl;
                 break;
             }
@@ -199,7 +464,7 @@ int main() {
             }
         }
         
-    } while (opcion != 5);
+    } while (opcion != 14);
     
     return 0;
 }
@@ -0,0 +1,175 @@
+#include "tree.h"
+#include "filtro_cuckoo.h"
+#include <algorithm>
+
+namespace {
+
+// Invalida el hash en caché del directorio de un manejador y de sus ancestros. Un hash inválido
+// implica que los de todos sus ancestros también lo son, así que se corta en el primero ya inválido
+void invalidarHashesManejador(const RanuraDirectorio& ranura) {
+    if (ranura.nodo->hashSubarbol == 0) return;
+    ranura.nodo->hashSubarbol = 0;
+    for (auto it = ranura.ancestros.rbegin(); it != ranura.ancestros.rend() && (*it)->hashSubarbol != 0; ++it) {
+        (*it)->hashSubarbol = 0;
+    }
+}
+
+} // namespace
+
+// Función para abrir un manejador sobre el directorio 'ruta' ("" es la raíz). Retorna un manejador
+// nulo (generación 0) si la ruta no existe. En un árbol compartido des-comparte el camino: un
+// directorio con manejador y sus ancestros nunca se comparten, así la copia en escritura no los
+// reemplaza mientras el manejador siga abierto
+ManejadorDirectorio ArbolSistemaArchivos::abrirDirectorio(const std::string& ruta) {
+    if (!raiz) return {0, 0};
+
+    std::vector<std::string> componentes = dividirRuta(ruta);
+    if (buscarDesde(raiz, componentes) == 1) return {0, 0};
+
+    std::uint32_t indice;
+    if (!ranurasLibres.empty()) {
+        indice = ranurasLibres.back();
+        ranurasLibres.pop_back();
+    } else {
+        indice = static_cast<std::uint32_t>(ranuras.size());
+        ranuras.push_back(RanuraDirectorio{nullptr, {}, "", 0, 1});
+    }
+
+    RanuraDirectorio& ranura = ranuras[indice];
+    NodoArbol* actual = raiz;
+    for (const std::string& componente : componentes) {
+        ranura.ancestros.push_back(actual);
+        NodoArbol* hijo = buscarHijo(actual, componente);
+        actual = hijo->referencias > 1 ? hijoPropio(actual, hijo) : hijo;
+        if (!ranura.ruta.empty()) ranura.ruta += '/';
+        ranura.ruta += componente;
+    }
+    ranura.nodo = actual;
+    ranura.estadoHash = estadoHashRuta(ranura.ruta);
+    manejadoresAbiertos++;
+
+    return {indice, ranura.generacion};
+}
+
+// Función para cerrar un manejador (no hace nada si ya era inválido)
+void ArbolSistemaArchivos::cerrarDirectorio(ManejadorDirectorio manejador) {
+    if (resolverManejador(manejador)) {
+        liberarRanura(manejador.ranura);
+    }
+}
+
+// Función para saber si un manejador sigue apuntando a un directorio vivo
+bool ArbolSistemaArchivos::manejadorValido(ManejadorDirectorio manejador) const {
+    return manejador.ranura < ranuras.size() && ranuras[manejador.ranura].nodo &&
+           ranuras[manejador.ranura].generacion == manejador.generacion;
+}
+
+// Función auxiliar que valida un manejador y retorna su ranura (nullptr si es inválido)
+RanuraDirectorio* ArbolSistemaArchivos::resolverManejador(ManejadorDirectorio manejador) {
+    return manejadorValido(manejador) ? &ranuras[manejador.ranura] : nullptr;
+}
+
+// Función auxiliar que libera una ranura avanzando su generación (la 0 queda para el manejador nulo)
+void ArbolSistemaArchivos::liberarRanura(std::uint32_t indice) {
+    RanuraDirectorio& ranura = ranuras[indice];
+    ranura.nodo = nullptr;
+    ranura.ancestros.clear();
+    ranura.ruta.clear();
+    if (++ranura.generacion == 0) {
+        ranura.generacion = 1;
+    }
+    ranurasLibres.push_back(indice);
+    manejadoresAbiertos--;
+}
+
+// Función auxiliar que invalida los manejadores del subárbol de un nodo a punto de soltarse.
+// Cuesta O(manejadores abiertos * profundidad), nada si no hay manejadores
+void ArbolSistemaArchivos::invalidarManejadoresBajo(const NodoArbol* nodo) {
+    if (manejadoresAbiertos == 0) return;
+    for (std::uint32_t i = 0; i < ranuras.size(); ++i) {
+        const RanuraDirectorio& ranura = ranuras[i];
+        if (ranura.nodo && (ranura.nodo == nodo ||
+                            std::find(ranura.ancestros.begin(), ranura.ancestros.end(), nodo) != ranura.ancestros.end())) {
+            liberarRanura(i);
+        }
+    }
+}
+
+// Función auxiliar que invalida todos los manejadores (el árbol completo se reemplazó)
+void ArbolSistemaArchivos::invalidarManejadores() {
+    for (std::uint32_t i = 0; i < ranuras.size() && manejadoresAbiertos > 0; ++i) {
+        if (ranuras[i].nodo) {
+            liberarRanura(i);
+        }
+    }
+}
+
+// Función de búsqueda relativa a un manejador: mismos códigos que buscar, o -1 si el manejador
+// es inválido. Solo tokeniza y baja por 'rutaRelativa', no por el camino hasta el directorio
+int ArbolSistemaArchivos::buscarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa) {
+    RanuraDirectorio* ranura = resolverManejador(manejador);
+    if (!ranura) return -1;
+    if (filtro && !filtro->contiene(finalizarEstadoRuta(extenderEstadoRuta(ranura->estadoHash, rutaRelativa)))) {
+        return 1; // Fallo seguro: el estado del directorio ya está calculado
+    }
+    return buscarDesde(ranura->nodo, dividirRuta(rutaRelativa));
+}
+
+// Función para insertar relativo a un manejador: mismos códigos que insertar, o -1 si el
+// manejador es inválido. El diario recibe la ruta completa, igual que con insertar
+int ArbolSistemaArchivos::insertarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa) {
+    RanuraDirectorio* ranura = resolverManejador(manejador);
+    if (!ranura) return -1;
+
+    std::vector<std::string> componentes = dividirRuta(rutaRelativa);
+    if (componentes.empty()) return 2; // Ruta inválida
+
+    if (buscarEn(manejador, rutaRelativa) != 1) {
+        return 1; // Ya existe
+    }
+
+    invalidarHashesManejador(*ranura);
+    NodoArbol* padre = bajarParaModificar(ranura->nodo, componentes);
+    if (!padre) {
+        return 2; // No existe la ruta padre
+    }
+    if (diario && !registrarEnDiario(true, ranura->ruta.empty() ? rutaRelativa : ranura->ruta + "/" + rutaRelativa)) {
+        return 3; // Sin registro no se aplica
+    }
+
+    NodoArbol* nuevoNodo = new NodoArbol(componentes.back());
+    insertarHijoOrdenado(padre, nuevoNodo);
+    if (filtro) {
+        registrarSubarbolEnFiltro(nuevoNodo, extenderEstadoRuta(ranura->estadoHash, rutaRelativa), true);
+    }
+
+    tomarPuntoControlPendiente();
+    return 0; // Éxito
+}
+
+// Función para eliminar relativo a un manejador (false también si el manejador es inválido).
+// Los manejadores abiertos dentro de lo eliminado quedan inválidos
+bool ArbolSistemaArchivos::eliminarEn(ManejadorDirectorio manejador, const std::string& rutaRelativa) {
+    RanuraDirectorio* ranura = resolverManejador(manejador);
+    if (!ranura) return false;
+
+    std::vector<std::string> componentes = dividirRuta(rutaRelativa);
+    if (componentes.empty()) return false;
+
+    invalidarHashesManejador(*ranura);
+    NodoArbol* padre = bajarParaModificar(ranura->nodo, componentes);
+    if (!padre) {
+        return false; // No existe la ruta padre
+    }
+
+    if (!buscarHijo(padre, componentes.back())) {
+        return false; // No existe el nodo
+    }
+    if (diario && !registrarEnDiario(false, ranura->ruta.empty() ? rutaRelativa : ranura->ruta + "/" + rutaRelativa)) {
+        return false; // Sin registro no se aplica
+    }
+
+    eliminarHijo(padre, componentes.back(), extenderEstadoRuta(ranura->estadoHash, rutaRelativa));
+    tomarPuntoControlPendiente();
+    return true;
+}
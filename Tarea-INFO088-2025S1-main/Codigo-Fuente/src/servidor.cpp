@@ -0,0 +1,557 @@
+#include "servidor.h"
+#include "tree.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t TAMANO_LECTURA = 64 * 1024;
+const size_t LIMITE_SALIDA = 8 * 1024 * 1024; // Con más salida pendiente se deja de leer al cliente
+const int MAX_EVENTOS = 256;
+
+std::atomic<bool> detener{false};
+
+void manejarSenal(int) {
+    detener = true;
+}
+
+// Responde una petición agregando la respuesta a 'salida' (sin escribir todavía)
+void responder(ArbolSistemaArchivos& arbol, std::string_view linea, std::string& salida) {
+    if (linea.empty()) return;
+    if (linea.size() > 1 && linea[1] != ' ') {
+        salida += "ERR\n";
+        return;
+    }
+
+    std::string ruta(linea.size() > 2 ? linea.substr(2) : std::string_view());
+    switch (linea[0]) {
+        case 'B':
+            salida += std::to_string(arbol.buscar(ruta));
+            break;
+        case 'I':
+            salida += std::to_string(arbol.insertar(ruta));
+            break;
+        case 'E':
+            salida += arbol.eliminar(ruta) ? '1' : '0';
+            break;
+        case 'L': {
+            std::vector<std::string> rutas = arbol.listarPorPrefijo(ruta);
+            salida += std::to_string(rutas.size());
+            for (const std::string& encontrada : rutas) {
+                salida += '\n';
+                salida += encontrada;
+            }
+            break;
+        }
+        default:
+            salida += "ERR";
+            break;
+    }
+    salida += '\n';
+}
+
+// Procesa todas las líneas completas de 'entrada' y deja el resto para la próxima lectura
+void atenderPeticiones(ArbolSistemaArchivos& arbol, std::string& entrada, std::string& salida) {
+    size_t inicio = 0;
+    size_t fin;
+    while ((fin = entrada.find('\n', inicio)) != std::string::npos) {
+        std::string_view linea(entrada.data() + inicio, fin - inicio);
+        if (!linea.empty() && linea.back() == '\r') {
+            linea.remove_suffix(1);
+        }
+        responder(arbol, linea, salida);
+        inicio = fin + 1;
+    }
+    entrada.erase(0, inicio);
+}
+
+// Escribe lo posible sin bloquear; retorna false si la conexión falló
+bool escribirPendiente(int fd, std::string& salida, size_t& enviados) {
+    while (enviados < salida.size()) {
+        ssize_t escritos = write(fd, salida.data() + enviados, salida.size() - enviados);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) return true;
+            return false;
+        }
+        enviados += static_cast<size_t>(escritos);
+    }
+    salida.clear();
+    enviados = 0;
+    return true;
+}
+
+struct Conexion {
+    std::string entrada;
+    std::string salida;
+    size_t enviados = 0;
+    bool finDeEntrada = false;
+};
+
+// Servidor de un solo hilo: el árbol no necesita cerrojos y epoll multiplexa a los clientes
+class Servidor {
+private:
+    ArbolSistemaArchivos& arbol;
+    int epoll;
+    int escucha;
+    bool entradaEstandarActiva;
+    bool salidaEstandarRegistrada;
+    int banderasSalidaEstandar;        // Banderas originales de stdout, para restaurarlas al terminar
+    std::unordered_map<int, Conexion> conexiones;
+
+    void actualizarInteres(int fd, const Conexion& conexion) {
+        epoll_event evento{};
+        evento.data.fd = fd;
+        if (!conexion.finDeEntrada && conexion.salida.size() < LIMITE_SALIDA) evento.events |= EPOLLIN;
+        if (!conexion.salida.empty()) evento.events |= EPOLLOUT;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &evento);
+    }
+
+    void cerrarConexion(int fd) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        conexiones.erase(fd);
+    }
+
+    void aceptar() {
+        while (true) {
+            int fd = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN: no quedan conexiones pendientes
+
+            epoll_event evento{};
+            evento.events = EPOLLIN;
+            evento.data.fd = fd;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &evento);
+            conexiones[fd];
+        }
+    }
+
+    void atenderCliente(int fd, unsigned eventos) {
+        Conexion& conexion = conexiones[fd];
+
+        if (eventos & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            char buffer[TAMANO_LECTURA];
+            ssize_t leidos = read(fd, buffer, sizeof(buffer));
+            if (leidos > 0) {
+                conexion.entrada.append(buffer, static_cast<size_t>(leidos));
+                atenderPeticiones(arbol, conexion.entrada, conexion.salida);
+            } else if (leidos == 0 || (errno != EAGAIN && errno != EINTR)) {
+                conexion.finDeEntrada = true;
+            }
+        }
+
+        if (!escribirPendiente(fd, conexion.salida, conexion.enviados) ||
+            (conexion.finDeEntrada && conexion.salida.empty())) {
+            cerrarConexion(fd);
+            return;
+        }
+        actualizarInteres(fd, conexion);
+    }
+
+    // stdin/stdout como una conexión más: stdout no bloquea y se vigila con EPOLLOUT solo mientras
+    // quede salida pendiente, para que un lector lento no detenga a los clientes del socket
+    void actualizarInteresEstandar(const Conexion& estandar) {
+        if (entradaEstandarActiva) {
+            epoll_event evento{};
+            evento.data.fd = STDIN_FILENO;
+            if (estandar.salida.size() < LIMITE_SALIDA) evento.events = EPOLLIN;
+            epoll_ctl(epoll, EPOLL_CTL_MOD, STDIN_FILENO, &evento);
+        }
+
+        bool pendiente = !estandar.salida.empty();
+        if (pendiente != salidaEstandarRegistrada) {
+            epoll_event evento{};
+            evento.events = EPOLLOUT;
+            evento.data.fd = STDOUT_FILENO;
+            epoll_ctl(epoll, pendiente ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, STDOUT_FILENO, &evento);
+            salidaEstandarRegistrada = pendiente;
+        }
+    }
+
+    // Una lectura de stdin por evento y respuesta en bloque (sin vaciar por línea)
+    void atenderEntradaEstandar(Conexion& estandar, int fd) {
+        if (fd == STDIN_FILENO && entradaEstandarActiva) {
+            char buffer[TAMANO_LECTURA];
+            ssize_t leidos = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (leidos > 0) {
+                estandar.entrada.append(buffer, static_cast<size_t>(leidos));
+                atenderPeticiones(arbol, estandar.entrada, estandar.salida);
+            } else if (leidos == 0 || (errno != EAGAIN && errno != EINTR)) {
+                estandar.entrada += '\n'; // Última línea sin salto
+                atenderPeticiones(arbol, estandar.entrada, estandar.salida);
+                epoll_ctl(epoll, EPOLL_CTL_DEL, STDIN_FILENO, nullptr);
+                entradaEstandarActiva = false;
+            }
+        }
+
+        if (!escribirPendiente(STDOUT_FILENO, estandar.salida, estandar.enviados)) {
+            std::cerr << "Error al escribir en la salida estándar: " << std::strerror(errno) << std::endl;
+            estandar.salida.clear();
+            estandar.enviados = 0;
+        }
+        actualizarInteresEstandar(estandar);
+    }
+
+public:
+    Servidor(ArbolSistemaArchivos& arbolServido, int descriptorEscucha)
+        : arbol(arbolServido), epoll(epoll_create1(EPOLL_CLOEXEC)), escucha(descriptorEscucha),
+          entradaEstandarActiva(false), salidaEstandarRegistrada(false), banderasSalidaEstandar(-1) {}
+
+    ~Servidor() {
+        if (banderasSalidaEstandar >= 0) {
+            fcntl(STDOUT_FILENO, F_SETFL, banderasSalidaEstandar);
+        }
+        for (auto& [fd, conexion] : conexiones) {
+            close(fd);
+        }
+        close(epoll);
+    }
+
+    // Registra stdin; retorna false si no admite epoll (p. ej. un archivo regular)
+    bool registrarEntradaEstandar() {
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.fd = STDIN_FILENO;
+        entradaEstandarActiva = epoll_ctl(epoll, EPOLL_CTL_ADD, STDIN_FILENO, &evento) == 0;
+        if (entradaEstandarActiva) {
+            banderasSalidaEstandar = fcntl(STDOUT_FILENO, F_GETFL);
+            if (banderasSalidaEstandar >= 0) {
+                fcntl(STDOUT_FILENO, F_SETFL, banderasSalidaEstandar | O_NONBLOCK);
+            }
+        }
+        return entradaEstandarActiva;
+    }
+
+    void ejecutar() {
+        if (escucha >= 0) {
+            epoll_event evento{};
+            evento.events = EPOLLIN;
+            evento.data.fd = escucha;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, escucha, &evento);
+        }
+
+        Conexion estandar;
+        epoll_event eventos[MAX_EVENTOS];
+        while (!detener && (escucha >= 0 || entradaEstandarActiva || !estandar.salida.empty())) {
+            int listos = epoll_wait(epoll, eventos, MAX_EVENTOS, -1);
+            if (listos < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "Error en epoll_wait: " << std::strerror(errno) << std::endl;
+                return;
+            }
+
+            for (int i = 0; i < listos; ++i) {
+                int fd = eventos[i].data.fd;
+                if (fd == escucha) {
+                    aceptar();
+                } else if (fd == STDIN_FILENO || fd == STDOUT_FILENO) {
+                    atenderEntradaEstandar(estandar, fd);
+                } else {
+                    atenderCliente(fd, eventos[i].events);
+                }
+            }
+        }
+    }
+};
+
+// Atiende stdin completo de forma síncrona (para entradas que epoll no admite)
+void atenderEntradaEstandarSincrona(ArbolSistemaArchivos& arbol) {
+    std::string entrada, salida;
+    char buffer[TAMANO_LECTURA];
+    ssize_t leidos;
+    while ((leidos = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+        entrada.append(buffer, static_cast<size_t>(leidos));
+        atenderPeticiones(arbol, entrada, salida);
+        if (salida.size() >= TAMANO_LECTURA) {
+            std::cout.write(salida.data(), static_cast<std::streamsize>(salida.size()));
+            salida.clear();
+        }
+    }
+    entrada += '\n';
+    atenderPeticiones(arbol, entrada, salida);
+    std::cout.write(salida.data(), static_cast<std::streamsize>(salida.size()));
+    std::cout.flush();
+}
+
+int crearSocketEscucha(const std::string& rutaSocket) {
+    sockaddr_un direccion{};
+    direccion.sun_family = AF_UNIX;
+    if (rutaSocket.size() >= sizeof(direccion.sun_path)) {
+        std::cerr << "Ruta de socket demasiado larga: " << rutaSocket << std::endl;
+        return -1;
+    }
+    std::memcpy(direccion.sun_path, rutaSocket.c_str(), rutaSocket.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    unlink(rutaSocket.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        std::cerr << "Error al escuchar en " << rutaSocket << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int conectar(const std::string& rutaSocket) {
+    sockaddr_un direccion{};
+    direccion.sun_family = AF_UNIX;
+    if (rutaSocket.size() >= sizeof(direccion.sun_path)) return -1;
+    std::memcpy(direccion.sun_path, rutaSocket.c_str(), rutaSocket.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Pide al servidor el listado completo ("L") para armar la carga con rutas reales
+std::vector<std::string> obtenerRutasDelServidor(int fd) {
+    std::vector<std::string> rutas;
+    const char peticion[] = "L \n";
+    if (write(fd, peticion, sizeof(peticion) - 1) < 0) return rutas;
+
+    std::string entrada;
+    char buffer[TAMANO_LECTURA];
+    long long esperadas = -1;
+    size_t inicio = 0;
+    while (esperadas < 0 || static_cast<long long>(rutas.size()) < esperadas) {
+        size_t fin = entrada.find('\n', inicio);
+        if (fin == std::string::npos) {
+            entrada.erase(0, inicio);
+            inicio = 0;
+            ssize_t leidos = read(fd, buffer, sizeof(buffer));
+            if (leidos <= 0) break;
+            entrada.append(buffer, static_cast<size_t>(leidos));
+            continue;
+        }
+        std::string linea = entrada.substr(inicio, fin - inicio);
+        inicio = fin + 1;
+        if (esperadas < 0) {
+            esperadas = std::stoll(linea);
+        } else {
+            rutas.push_back(std::move(linea));
+        }
+    }
+    return rutas;
+}
+
+struct ConexionCliente {
+    int fd = -1;
+    std::string entrada;
+    std::string salida;
+    size_t enviados = 0;
+    bool esperandoEscritura = false; // EPOLLOUT armado: solo mientras queda salida sin enviar
+    std::deque<std::chrono::steady_clock::time_point> enVuelo;
+};
+
+} // namespace
+
+// Función para cargar el árbol una vez y atender peticiones por stdin/stdout y socket Unix
+int ejecutarServidor(const ConfiguracionServidor& configuracion) {
+    std::signal(SIGPIPE, SIG_IGN);
+    struct sigaction accion{};
+    accion.sa_handler = manejarSenal;
+    sigaction(SIGINT, &accion, nullptr);
+    sigaction(SIGTERM, &accion, nullptr);
+
+    ArbolSistemaArchivos arbol;
+    auto inicio = std::chrono::high_resolution_clock::now();
+    arbol.cargarDatos(configuracion.rutaDatos);
+    auto fin = std::chrono::high_resolution_clock::now();
+    std::cerr << "Árbol cargado: " << arbol.obtenerNumeroNodos() << " nodos en "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(fin - inicio).count() << " ms" << std::endl;
+
+    int escucha = -1;
+    if (!configuracion.rutaSocket.empty()) {
+        escucha = crearSocketEscucha(configuracion.rutaSocket);
+        if (escucha < 0) return 1;
+        std::cerr << "Escuchando en " << configuracion.rutaSocket << std::endl;
+    }
+
+    {
+        Servidor servidor(arbol, escucha);
+        if (configuracion.usarEntradaEstandar && !servidor.registrarEntradaEstandar()) {
+            atenderEntradaEstandarSincrona(arbol);
+        }
+        servidor.ejecutar();
+    }
+
+    if (escucha >= 0) {
+        close(escucha);
+        unlink(configuracion.rutaSocket.c_str());
+    }
+    return 0;
+}
+
+// Función generadora de carga: mantiene 'profundidadPipeline' peticiones en vuelo por conexión
+// y mide la latencia extremo a extremo de cada una
+int ejecutarClienteCarga(const ConfiguracionCliente& configuracion) {
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fdInicial = conectar(configuracion.rutaSocket);
+    if (fdInicial < 0) {
+        std::cerr << "No se pudo conectar a " << configuracion.rutaSocket << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::vector<std::string> rutas = obtenerRutasDelServidor(fdInicial);
+    close(fdInicial);
+    if (rutas.empty()) {
+        std::cerr << "El servidor no informó rutas para generar carga" << std::endl;
+        return 1;
+    }
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<ConexionCliente> conexiones(static_cast<size_t>(std::max(1, configuracion.conexiones)));
+    for (size_t i = 0; i < conexiones.size(); ++i) {
+        conexiones[i].fd = conectar(configuracion.rutaSocket);
+        if (conexiones[i].fd < 0) {
+            std::cerr << "No se pudo abrir la conexión " << i << std::endl;
+            return 1;
+        }
+        fcntl(conexiones[i].fd, F_SETFL, fcntl(conexiones[i].fd, F_GETFL) | O_NONBLOCK);
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.u64 = i;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, conexiones[i].fd, &evento);
+    }
+
+    std::mt19937_64 gen(12345);
+    std::uniform_int_distribution<size_t> distRuta(0, rutas.size() - 1);
+    std::uniform_real_distribution<> moneda(0.0, 1.0);
+    std::vector<std::string> insertadas;
+    long long enviadas = 0, recibidas = 0, creadas = 0;
+    std::vector<long long> latencias;
+    latencias.reserve(static_cast<size_t>(configuracion.peticiones));
+
+    // Completa el pipeline de una conexión y envía todo en una sola escritura
+    auto llenar = [&](ConexionCliente& conexion) {
+        while (static_cast<int>(conexion.enVuelo.size()) < configuracion.profundidadPipeline &&
+               enviadas < configuracion.peticiones) {
+            if (moneda(gen) < configuracion.proporcionEscrituras) {
+                if (!insertadas.empty() && moneda(gen) < 0.5) {
+                    conexion.salida += "E " + insertadas.back() + "\n";
+                    insertadas.pop_back();
+                } else {
+                    std::string nueva = rutas[distRuta(gen)] + "_carga_" + std::to_string(creadas++);
+                    conexion.salida += "I " + nueva + "\n";
+                    insertadas.push_back(std::move(nueva));
+                }
+            } else {
+                conexion.salida += "B " + rutas[distRuta(gen)] + "\n";
+            }
+            conexion.enVuelo.push_back(std::chrono::steady_clock::now());
+            enviadas++;
+        }
+        return escribirPendiente(conexion.fd, conexion.salida, conexion.enviados);
+    };
+
+    // Arma EPOLLOUT solo si quedó salida pendiente (en nivel, armado sin nada que enviar giraría en vacío)
+    auto actualizarInteres = [&](size_t indice) {
+        ConexionCliente& conexion = conexiones[indice];
+        bool pendiente = !conexion.salida.empty();
+        if (pendiente == conexion.esperandoEscritura) return;
+        epoll_event evento{};
+        evento.events = pendiente ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        evento.data.u64 = indice;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, conexion.fd, &evento);
+        conexion.esperandoEscritura = pendiente;
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < conexiones.size(); ++i) {
+        if (!llenar(conexiones[i])) {
+            std::cerr << "Error al escribir al servidor: " << std::strerror(errno) << std::endl;
+            recibidas = configuracion.peticiones;
+            break;
+        }
+        actualizarInteres(i);
+    }
+
+    epoll_event eventos[MAX_EVENTOS];
+    while (recibidas < configuracion.peticiones) {
+        int listos = epoll_wait(epoll, eventos, MAX_EVENTOS, 1000);
+        if (listos < 0 && errno != EINTR) break;
+        if (listos == 0) {
+            std::cerr << "Tiempo de espera agotado: el servidor dejó de responder" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < listos; ++i) {
+            ConexionCliente& conexion = conexiones[eventos[i].data.u64];
+            if (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                char buffer[TAMANO_LECTURA];
+                ssize_t leidos = read(conexion.fd, buffer, sizeof(buffer));
+                if (leidos == 0 || (leidos < 0 && errno != EAGAIN && errno != EINTR)) {
+                    std::cerr << "El servidor cerró la conexión" << std::endl;
+                    recibidas = configuracion.peticiones;
+                    break;
+                }
+                if (leidos > 0) {
+                    conexion.entrada.append(buffer, static_cast<size_t>(leidos));
+                }
+
+                auto ahora = std::chrono::steady_clock::now();
+                size_t pos = 0, fin;
+                while ((fin = conexion.entrada.find('\n', pos)) != std::string::npos && !conexion.enVuelo.empty()) {
+                    latencias.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(ahora - conexion.enVuelo.front()).count());
+                    conexion.enVuelo.pop_front();
+                    recibidas++;
+                    pos = fin + 1;
+                }
+                conexion.entrada.erase(0, pos);
+            }
+            if (!llenar(conexion)) {
+                std::cerr << "Error al escribir al servidor: " << std::strerror(errno) << std::endl;
+                recibidas = configuracion.peticiones;
+                break;
+            }
+            actualizarInteres(eventos[i].data.u64);
+        }
+    }
+    auto fin = std::chrono::steady_clock::now();
+
+    for (ConexionCliente& conexion : conexiones) {
+        close(conexion.fd);
+    }
+    close(epoll);
+
+    if (latencias.empty()) return 1;
+
+    std::sort(latencias.begin(), latencias.end());
+    auto percentil = [&latencias](double p) {
+        size_t indice = std::min(latencias.size() - 1, static_cast<size_t>(p * static_cast<double>(latencias.size())));
+        return static_cast<double>(latencias[indice]) / 1000.0;
+    };
+    double segundos = std::chrono::duration<double>(fin - inicio).count();
+
+    std::cout << "Conexiones: " << conexiones.size() << ", pipeline: " << configuracion.profundidadPipeline
+              << ", escrituras: " << configuracion.proporcionEscrituras << std::endl;
+    std::cout << "Peticiones respondidas: " << latencias.size() << " en " << std::fixed << std::setprecision(3)
+              << segundos << " s" << std::endl;
+    std::cout << "QPS: " << std::setprecision(0) << static_cast<double>(latencias.size()) / segundos << std::endl;
+    std::cout << std::setprecision(1) << "Latencia (us) p50: " << percentil(0.50) << "  p90: " << percentil(0.90)
+              << "  p99: " << percentil(0.99) << "  p99.9: " << percentil(0.999)
+              << "  máx: " << static_cast<double>(latencias.back()) / 1000.0 << std::endl;
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "tree.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Tabla de hash-consing: hash estructural del subárbol -> nodos canónicos con ese hash
+using TablaCanonicos = std::unordered_multimap<std::uint64_t, NodoArbol*>;
+
+// Dos nodos son intercambiables si coinciden en nombre y metadatos y sus hijos (ya canónicos)
+// son exactamente los mismos nodos
+bool mismoNodo(const NodoArbol* a, const NodoArbol* b) {
+    return a->nombre == b->nombre && a->tipo == b->tipo && a->tamano == b->tamano && a->hijos == b->hijos;
+}
+
+// Función auxiliar recursiva que retorna el representante canónico de un subárbol, canonizando
+// antes a sus hijos (de abajo hacia arriba). Cuenta en 'liberados' los nodos que se destruyen.
+// Los nodos 'protegidos' (caminos de manejadores abiertos) no se reemplazan ni sirven de canónicos
+NodoArbol* canonizar(NodoArbol* nodo, TablaCanonicos& tabla, const std::unordered_set<const NodoArbol*>& protegidos,
+                     long long& liberados) {
+    // Un nodo ya compartido y registrado en esta pasada no necesita recorrerse otra vez
+    if (nodo->referencias > 1 && nodo->hashSubarbol != 0) {
+        auto [desde, hasta] = tabla.equal_range(nodo->hashSubarbol);
+        for (auto it = desde; it != hasta; ++it) {
+            if (it->second == nodo) return nodo;
+        }
+    }
+
+    for (NodoArbol*& hijo : nodo->hijos) {
+        NodoArbol* canonico = canonizar(hijo, tabla, protegidos, liberados);
+        if (canonico != hijo) {
+            canonico->referencias++;
+            if (--hijo->referencias == 0) {
+                delete hijo; // Sus hijos también son del canónico: solo pierden una referencia
+                liberados++;
+            }
+            hijo = canonico;
+        }
+    }
+
+    if (!protegidos.empty() && protegidos.count(nodo)) return nodo;
+
+    std::uint64_t hash = ArbolSistemaArchivos::hashSubarbol(nodo);
+    auto [desde, hasta] = tabla.equal_range(hash);
+    for (auto it = desde; it != hasta; ++it) {
+        if (it->second == nodo || mismoNodo(it->second, nodo)) return it->second;
+    }
+    tabla.emplace(hash, nodo);
+    return nodo;
+}
+
+} // namespace
+
+// Función para compartir los subárboles idénticos (hash-consing): el árbol pasa a ser un DAG en
+// el que cada subárbol distinto existe una sola vez. Pensado para árboles de mucha lectura:
+// buscar no cambia, e insertar/eliminar/insertarRuta des-comparten (copia en escritura) solo los
+// nodos del camino que modifican. Se puede volver a llamar tras mutar. Los directorios con
+// manejador abierto y sus ancestros quedan fuera para que el manejador no quede apuntando a un
+// nodo compartido. Retorna los nodos liberados
+long long ArbolSistemaArchivos::compartirSubarboles() {
+    if (!raiz) return 0;
+
+    std::unordered_set<const NodoArbol*> protegidos;
+    for (const RanuraDirectorio& ranura : ranuras) {
+        if (!ranura.nodo) continue;
+        protegidos.insert(ranura.nodo);
+        protegidos.insert(ranura.ancestros.begin(), ranura.ancestros.end());
+    }
+
+    TablaCanonicos tabla;
+    long long liberados = 0;
+    canonizar(raiz, tabla, protegidos, liberados);
+    compartido = true;
+    return liberados;
+}
@@ -1,24 +1,82 @@
 #include "tree.h"
+#include "diario.h"
+#include "filtro_cuckoo.h"
+#include "indice_hijos.h"
+#include "visitante_paralelo.h"
 #include <algorithm>
+#include <bit>
 #include <filesystem>
 #include <iostream>
+#include <unordered_set>
+
+namespace {
+
+const std::uint64_t FNV_BASE = 14695981039346656037ull;
+const std::uint64_t FNV_PRIMO = 1099511628211ull;
+
+// Agrega "/componente" al estado FNV-1a de una ruta: así el hash de un hijo sale del de su padre
+std::uint64_t extenderHashRuta(std::uint64_t estado, const std::string& componente) {
+    estado = (estado ^ static_cast<unsigned char>('/')) * FNV_PRIMO;
+    for (char c : componente) {
+        estado = (estado ^ static_cast<unsigned char>(c)) * FNV_PRIMO;
+    }
+    return estado;
+}
+
+// Mezcla final (splitmix64): el filtro usa los bits bajos como cubeta y los altos como huella
+std::uint64_t finalizarHashRuta(std::uint64_t estado) {
+    estado ^= estado >> 30;
+    estado *= 0xBF58476D1CE4E5B9ull;
+    estado ^= estado >> 27;
+    estado *= 0x94D049BB133111EBull;
+    return estado ^ (estado >> 31);
+}
+
+} // namespace
 
 // Constructor del nodo
-NodoArbol::NodoArbol(const std::string& nombre) : nombre(nombre) {}
+NodoArbol::NodoArbol(const std::string& nombre)
+    : nombre(nombre), tamano(0), tipo(TipoNodo::Desconocido), referencias(1), hashSubarbol(0), indice(nullptr) {}
 
-// Destructor del nodo
+// Destructor del nodo (un hijo compartido solo se libera al soltarlo su último padre)
 NodoArbol::~NodoArbol() {
     for (auto* hijo : hijos) {
-        delete hijo;
+        if (--hijo->referencias == 0) {
+            delete hijo;
+        }
     }
+    delete indice;
 }
 
 // Constructor del árbol
-ArbolSistemaArchivos::ArbolSistemaArchivos() : raiz(nullptr) {}
+ArbolSistemaArchivos::ArbolSistemaArchivos()
+    : raiz(nullptr), diario(nullptr), filtro(nullptr), compartido(false), manejadoresAbiertos(0) {}
+
+// Constructor de copia (copia profunda, que expande los subárboles compartidos; el diario y el
+// filtro no se comparten, y los manejadores de directorio siguen siendo del original)
+ArbolSistemaArchivos::ArbolSistemaArchivos(const ArbolSistemaArchivos& otro)
+    : raiz(otro.raiz ? clonarSubarbol(otro.raiz) : nullptr), diario(nullptr), filtro(nullptr), compartido(false),
+      manejadoresAbiertos(0) {}
+
+// Asignación por copia
+ArbolSistemaArchivos& ArbolSistemaArchivos::operator=(const ArbolSistemaArchivos& otro) {
+    if (this != &otro) {
+        NodoArbol* copia = otro.raiz ? clonarSubarbol(otro.raiz) : nullptr;
+        delete raiz;
+        raiz = copia;
+        compartido = false;
+        invalidarManejadores();
+        if (filtro) {
+            reconstruirFiltro();
+        }
+    }
+    return *this;
+}
 
 // Destructor del árbol
 ArbolSistemaArchivos::~ArbolSistemaArchivos() {
     delete raiz;
+    delete filtro;
 }
 
 // Función para cargar datos del sistema de archivos
@@ -26,9 +84,14 @@ void ArbolSistemaArchivos::cargarDatos(const std::string& rutaBase) {
     if (raiz) {
         delete raiz;
     }
+    compartido = false;
+    invalidarManejadores();
     
     // Crear nodo raíz
     raiz = new NodoArbol("raiz");
+    if (filtro) {
+        reconstruirFiltro(); // Vacío: crece a medida que insertarRuta agrega rutas
+    }
     
     try {
         // Recorrer el directorio de forma recursiva
@@ -41,23 +104,39 @@ void ArbolSistemaArchivos::cargarDatos(const std::string& rutaBase) {
     }
 }
 
-// Función para insertar una ruta en el árbol
-void ArbolSistemaArchivos::insertarRuta(const std::string& ruta) {
+// Función para obtener la raíz (punto de partida de visitarParalelo; nullptr si no hay datos)
+const NodoArbol* ArbolSistemaArchivos::obtenerRaiz() const {
+    return raiz;
+}
+
+// Función para insertar una ruta en el árbol (retorna el nodo final de la ruta)
+NodoArbol* ArbolSistemaArchivos::insertarRuta(const std::string& ruta) {
     if (!raiz) {
         raiz = new NodoArbol("raiz");
     }
     
     std::vector<std::string> componentes = dividirRuta(ruta);
     NodoArbol* actual = raiz;
+    std::uint64_t estado = FNV_BASE;
     
     for (const std::string& componente : componentes) {
+        actual->hashSubarbol = 0; // El subárbol puede cambiar
+        estado = extenderHashRuta(estado, componente);
         NodoArbol* hijo = buscarHijo(actual, componente);
+        if (hijo && hijo->referencias > 1) {
+            hijo = hijoPropio(actual, hijo); // El llamador puede modificar el nodo retornado
+        }
         if (!hijo) {
             hijo = new NodoArbol(componente);
             insertarHijoOrdenado(actual, hijo);
+            if (filtro) {
+                registrarSubarbolEnFiltro(hijo, estado, true);
+            }
         }
         actual = hijo;
     }
+    
+    return actual;
 }
 
 // Función para dividir una ruta en componentes
@@ -87,6 +166,16 @@ std::vector<std::string> ArbolSistemaArchivos::dividirRuta(const std::string& ru
 NodoArbol* ArbolSistemaArchivos::buscarHijo(NodoArbol* nodo, const std::string& nombre) {
     if (!nodo) return nullptr;
     
+    // Directorios grandes: índice Eytzinger sin saltos (si ya amortizó su reconstrucción)
+    if (nodo->hijos.size() >= UMBRAL_INDICE_HIJOS) {
+        if (!nodo->indice) {
+            nodo->indice = new IndiceHijos();
+        }
+        if (nodo->indice->preparar(nodo->hijos)) {
+            return nodo->indice->buscar(nodo->hijos, nombre);
+        }
+    }
+    
     // Búsqueda binaria en el vector ordenado
     int izq = 0, der = static_cast<int>(nodo->hijos.size()) - 1;
     
@@ -105,6 +194,25 @@ NodoArbol* ArbolSistemaArchivos::buscarHijo(NodoArbol* nodo, const std::string&
     return nullptr;
 }
 
+// Función para des-compartir (copia en escritura) un hijo compartido antes de modificar su subárbol.
+// Se copia solo el nodo: sus hijos quedan con un padre más y se des-comparten al bajar por ellos
+NodoArbol* ArbolSistemaArchivos::hijoPropio(NodoArbol* padre, NodoArbol* hijo) {
+    NodoArbol* copia = new NodoArbol(hijo->nombre);
+    copia->tamano = hijo->tamano;
+    copia->tipo = hijo->tipo;
+    copia->hashSubarbol = hijo->hashSubarbol;
+    copia->hijos = hijo->hijos;
+    for (NodoArbol* nieto : copia->hijos) {
+        nieto->referencias++;
+    }
+    hijo->referencias--;
+
+    auto it = std::lower_bound(padre->hijos.begin(), padre->hijos.end(), hijo->nombre,
+        [](const NodoArbol* a, const std::string& b) { return a->nombre < b; });
+    *it = copia;
+    return copia;
+}
+
 // Función para insertar un hijo manteniendo el orden lexicográfico
 void ArbolSistemaArchivos::insertarHijoOrdenado(NodoArbol* padre, NodoArbol* hijo) {
     if (!padre || !hijo) return;
@@ -116,14 +224,22 @@ void ArbolSistemaArchivos::insertarHijoOrdenado(NodoArbol* padre, NodoArbol* hij
         });
     
     padre->hijos.insert(it, hijo);
+    if (padre->indice) {
+        padre->indice->invalidar();
+    }
 }
 
 // Función de búsqueda por ruta
 int ArbolSistemaArchivos::buscar(const std::string& ruta) {
     if (!raiz) return 1; // No existe
+    if (filtro && !filtro->contiene(hashRuta(ruta))) return 1; // Fallo seguro: sin tokenizar ni bajar
     
-    std::vector<std::string> componentes = dividirRuta(ruta);
-    NodoArbol* actual = raiz;
+    return buscarDesde(raiz, dividirRuta(ruta));
+}
+
+// Función auxiliar de búsqueda a partir de un nodo (la raíz o el directorio de un manejador)
+int ArbolSistemaArchivos::buscarDesde(NodoArbol* inicio, const std::vector<std::string>& componentes) {
+    NodoArbol* actual = inicio;
     
     for (const std::string& componente : componentes) {
         actual = buscarHijo(actual, componente);
@@ -140,7 +256,8 @@ int ArbolSistemaArchivos::buscar(const std::string& ruta) {
     }
 }
 
-// Función para insertar un nuevo archivo/directorio
+// Función para insertar un nuevo archivo/directorio (0 éxito, 1 ya existe, 2 ruta inválida,
+// 3 no se pudo registrar en el diario: el árbol no cambia)
 int ArbolSistemaArchivos::insertar(const std::string& ruta) {
     if (!raiz) {
         raiz = new NodoArbol("raiz");
@@ -154,19 +271,24 @@ int ArbolSistemaArchivos::insertar(const std::string& ruta) {
         return 1; // Ya existe
     }
     
-    // Encontrar el directorio padre
-    NodoArbol* padre = raiz;
-    for (size_t i = 0; i < componentes.size() - 1; ++i) {
-        padre = buscarHijo(padre, componentes[i]);
-        if (!padre) {
-            return 2; // No existe la ruta padre
-        }
+    // Encontrar el directorio padre, invalidando los hashes del camino
+    raiz->hashSubarbol = 0;
+    NodoArbol* padre = bajarParaModificar(raiz, componentes);
+    if (!padre) {
+        return 2; // No existe la ruta padre
+    }
+    if (!registrarEnDiario(true, ruta)) {
+        return 3; // Sin registro no se aplica
     }
     
     // Insertar el nuevo nodo
     NodoArbol* nuevoNodo = new NodoArbol(componentes.back());
     insertarHijoOrdenado(padre, nuevoNodo);
+    if (filtro) {
+        registrarSubarbolEnFiltro(nuevoNodo, estadoHashRuta(ruta), true);
+    }
     
+    tomarPuntoControlPendiente();
     return 0; // Éxito
 }
 
@@ -177,62 +299,119 @@ bool ArbolSistemaArchivos::eliminar(const std::string& ruta) {
     std::vector<std::string> componentes = dividirRuta(ruta);
     if (componentes.empty()) return false;
     
-    // Encontrar el nodo padre
-    NodoArbol* padre = raiz;
-    for (size_t i = 0; i < componentes.size() - 1; ++i) {
-        padre = buscarHijo(padre, componentes[i]);
-        if (!padre) {
-            return false; // No existe la ruta padre
-        }
+    // Encontrar el nodo padre, invalidando los hashes del camino
+    raiz->hashSubarbol = 0;
+    NodoArbol* padre = bajarParaModificar(raiz, componentes);
+    if (!padre) {
+        return false; // No existe la ruta padre
     }
     
-    // Buscar el nodo a eliminar
-    std::string nombreAEliminar = componentes.back();
+    if (!buscarHijo(padre, componentes.back())) {
+        return false; // No existe el nodo
+    }
+    if (!registrarEnDiario(false, ruta)) {
+        return false; // Sin registro no se aplica
+    }
+    
+    eliminarHijo(padre, componentes.back(), estadoHashRuta(ruta));
+    tomarPuntoControlPendiente();
+    return true;
+}
+
+// Función auxiliar que baja hasta el padre del último componente des-compartiendo los nodos
+// compartidos e invalidando sus hashes (el de 'inicio' lo invalida el llamador). Retorna nullptr
+// si falta algún directorio intermedio
+NodoArbol* ArbolSistemaArchivos::bajarParaModificar(NodoArbol* inicio, const std::vector<std::string>& componentes) {
+    NodoArbol* padre = inicio;
+    for (size_t i = 0; i + 1 < componentes.size(); ++i) {
+        NodoArbol* hijo = buscarHijo(padre, componentes[i]);
+        if (!hijo) {
+            return nullptr;
+        }
+        padre = hijo->referencias > 1 ? hijoPropio(padre, hijo) : hijo;
+        padre->hashSubarbol = 0;
+    }
+    return padre;
+}
+
+// Función auxiliar que suelta el hijo 'nombre' de 'padre' ('estado' es el estado FNV de su ruta)
+bool ArbolSistemaArchivos::eliminarHijo(NodoArbol* padre, const std::string& nombre, std::uint64_t estado) {
     auto it = std::find_if(padre->hijos.begin(), padre->hijos.end(),
-        [&nombreAEliminar](const NodoArbol* nodo) {
-            return nodo->nombre == nombreAEliminar;
+        [&nombre](const NodoArbol* nodo) {
+            return nodo->nombre == nombre;
         });
     
     if (it == padre->hijos.end()) {
-        return false; // No existe el nodo
+        return false;
     }
     
-    // Eliminar el nodo (el destructor se encarga de eliminar el subárbol)
-    delete *it;
+    // Soltar el nodo (el destructor se encarga del subárbol; si está compartido sigue vivo en sus otros padres)
+    invalidarManejadoresBajo(*it);
+    if (filtro) {
+        registrarSubarbolEnFiltro(*it, estado, false);
+    }
+    if (--(*it)->referencias == 0) {
+        delete *it;
+    }
     padre->hijos.erase(it);
-    
+    if (padre->indice) {
+        padre->indice->invalidar();
+    }
     return true;
 }
 
-// Función para obtener la altura del árbol
-int ArbolSistemaArchivos::obtenerAltura() const {
-    return obtenerAltura(raiz);
+// Función auxiliar que anota una mutación válida en el diario antes de aplicarla; retorna false
+// si el diario la rechazó (en ese caso no debe aplicarse)
+bool ArbolSistemaArchivos::registrarEnDiario(bool insercion, const std::string& ruta) {
+    if (!diario) return true;
+    return insercion ? diario->registrarInsercion(ruta) : diario->registrarEliminacion(ruta);
+}
+
+// Función auxiliar que toma el punto de control que toque, ya aplicada la mutación
+void ArbolSistemaArchivos::tomarPuntoControlPendiente() {
+    if (diario && diario->puntoControlPendiente()) {
+        diario->guardarPuntoControl(*this);
+    }
+}
+
+// Función para obtener la altura del árbol (número de niveles, la raíz cuenta). Con hilos != 1
+// usa visitarParalelo (0 = todos los núcleos); por defecto es un recorrido recursivo sin asignaciones
+int ArbolSistemaArchivos::obtenerAltura(unsigned hilos) const {
+    if (hilos == 1) return obtenerAlturaRecursivo(raiz);
+    return visitarParalelo(raiz, 0,
+        [](int& altura, const NodoArbol&, const ContextoVisita& contexto) {
+            altura = std::max(altura, contexto.profundidad() + 1);
+        },
+        [](int& altura, int otra) { altura = std::max(altura, otra); }, hilos);
 }
 
 // Función auxiliar recursiva para obtener la altura
-int ArbolSistemaArchivos::obtenerAltura(NodoArbol* nodo) const {
+int ArbolSistemaArchivos::obtenerAlturaRecursivo(NodoArbol* nodo) const {
     if (!nodo) return 0;
     
     int maxAltura = 0;
     for (NodoArbol* hijo : nodo->hijos) {
-        maxAltura = std::max(maxAltura, obtenerAltura(hijo));
+        maxAltura = std::max(maxAltura, obtenerAlturaRecursivo(hijo));
     }
     
     return maxAltura + 1;
 }
 
-// Función para obtener el número total de nodos
-int ArbolSistemaArchivos::obtenerNumeroNodos() const {
-    return obtenerNumeroNodos(raiz);
+// Función para obtener el número total de nodos (hilos como en obtenerAltura)
+int ArbolSistemaArchivos::obtenerNumeroNodos(unsigned hilos) const {
+    if (hilos == 1) return obtenerNumeroNodosRecursivo(raiz);
+    return visitarParalelo(raiz, 0,
+        [](int& contador, const NodoArbol&, const ContextoVisita&) { contador++; },
+        [](int& contador, int otro) { contador += otro; }, hilos);
 }
 
 // Función auxiliar recursiva para contar nodos
-int ArbolSistemaArchivos::obtenerNumeroNodos(NodoArbol* nodo) const {
+int ArbolSistemaArchivos::obtenerNumeroNodosRecursivo(NodoArbol* nodo) const {
     if (!nodo) return 0;
     
     int contador = 1; // Contar el nodo actual
     for (NodoArbol* hijo : nodo->hijos) {
-        contador += obtenerNumeroNodos(hijo);
+        contador += obtenerNumeroNodosRecursivo(hijo);
     }
     
     return contador;
@@ -251,7 +430,11 @@ std::vector<std::string> ArbolSistemaArchivos::obtenerTodasLasRutas() const {
 void ArbolSistemaArchivos::obtenerRutasRecursivo(NodoArbol* nodo, const std::string& rutaActual, std::vector<std::string>& rutas) const {
     if (!nodo) return;
     
-    std::string nuevaRuta = rutaActual.empty() ? nodo->nombre : rutaActual + "/" + nodo->nombre;
+    // La raíz no forma parte de las rutas: buscar/insertar/eliminar parten desde ella
+    std::string nuevaRuta;
+    if (nodo != raiz) {
+        nuevaRuta = rutaActual.empty() ? nodo->nombre : rutaActual + "/" + nodo->nombre;
+    }
     
     // Si es un nodo hoja (archivo), agregar la ruta
     if (nodo->hijos.empty() && nodo != raiz) {
@@ -277,7 +460,11 @@ std::vector<std::string> ArbolSistemaArchivos::obtenerTodosLosDirectorios() cons
 void ArbolSistemaArchivos::obtenerDirectoriosRecursivo(NodoArbol* nodo, const std::string& rutaActual, std::vector<std::string>& directorios) const {
     if (!nodo) return;
     
-    std::string nuevaRuta = rutaActual.empty() ? nodo->nombre : rutaActual + "/" + nodo->nombre;
+    // La raíz no forma parte de las rutas: buscar/insertar/eliminar parten desde ella
+    std::string nuevaRuta;
+    if (nodo != raiz) {
+        nuevaRuta = rutaActual.empty() ? nodo->nombre : rutaActual + "/" + nodo->nombre;
+    }
     
     // Si no es un nodo hoja y no es la raíz, es un directorio
     if (!nodo->hijos.empty() && nodo != raiz) {
@@ -289,3 +476,264 @@ void ArbolSistemaArchivos::obtenerDirectoriosRecursivo(NodoArbol* nodo, const st
         obtenerDirectoriosRecursivo(hijo, nuevaRuta, directorios);
     }
 }
+
+// Función para listar en preorden todas las rutas (archivos y directorios) que empiezan con 'prefijo'
+std::vector<std::string> ArbolSistemaArchivos::listarPorPrefijo(const std::string& prefijo) const {
+    std::vector<std::string> rutas;
+    if (!raiz) return rutas;
+    
+    // Separar los directorios completos del componente parcial final
+    size_t corte = prefijo.find_last_of("/\\");
+    std::string parcial = corte == std::string::npos ? prefijo : prefijo.substr(corte + 1);
+    std::vector<std::string> componentes = dividirRuta(corte == std::string::npos ? "" : prefijo.substr(0, corte));
+    
+    auto menorQue = [](const NodoArbol* a, const std::string& b) { return a->nombre < b; };
+    const NodoArbol* actual = raiz;
+    std::string ruta;
+    for (const std::string& componente : componentes) {
+        auto it = std::lower_bound(actual->hijos.begin(), actual->hijos.end(), componente, menorQue);
+        if (it == actual->hijos.end() || (*it)->nombre != componente) {
+            return rutas; // No existe el directorio
+        }
+        actual = *it;
+        ruta += (ruta.empty() ? "" : "/") + componente;
+    }
+    
+    // Los hijos están ordenados: los que empiezan con 'parcial' forman un rango contiguo
+    size_t largoBase = ruta.size();
+    for (auto it = std::lower_bound(actual->hijos.begin(), actual->hijos.end(), parcial, menorQue);
+         it != actual->hijos.end() && (*it)->nombre.compare(0, parcial.size(), parcial) == 0; ++it) {
+        if (largoBase > 0) ruta += '/';
+        listarSubarbol(*it, ruta, rutas);
+        ruta.resize(largoBase);
+    }
+    
+    return rutas;
+}
+
+// Función auxiliar recursiva para listar un subárbol extendiendo 'ruta' en el lugar
+void ArbolSistemaArchivos::listarSubarbol(const NodoArbol* nodo, std::string& ruta, std::vector<std::string>& rutas) const {
+    ruta += nodo->nombre;
+    rutas.push_back(ruta);
+    
+    size_t largo = ruta.size();
+    for (const NodoArbol* hijo : nodo->hijos) {
+        ruta += '/';
+        listarSubarbol(hijo, ruta, rutas);
+        ruta.resize(largo);
+    }
+}
+
+// Función para adjuntar (o quitar con nullptr) el diario de mutaciones
+void ArbolSistemaArchivos::adjuntarDiario(DiarioMutaciones* diarioMutaciones) {
+    diario = diarioMutaciones;
+}
+
+namespace {
+
+// Tamaño real de un bloque de malloc en glibc: 8 bytes de cabecera, alineado a 16, mínimo 32
+long long bloqueAsignador(size_t solicitado) {
+    return static_cast<long long>(std::max<size_t>(32, (solicitado + 8 + 15) & ~static_cast<size_t>(15)));
+}
+
+} // namespace
+
+// Función para obtener la huella de memoria del árbol por categoría
+EstadisticasMemoria ArbolSistemaArchivos::estadisticasMemoria() const {
+    auto combinar = [](EstadisticasMemoria& destino, const EstadisticasMemoria& parcial) {
+        destino.nodos += parcial.nodos;
+        destino.bytesNodos += parcial.bytesNodos;
+        destino.bytesNombres += parcial.bytesNombres;
+        destino.bytesHijos += parcial.bytesHijos;
+        destino.bytesHolgura += parcial.bytesHolgura;
+        destino.bytesSobrecarga += parcial.bytesSobrecarga;
+        if (destino.histogramaGrado.size() < parcial.histogramaGrado.size()) {
+            destino.histogramaGrado.resize(parcial.histogramaGrado.size(), 0);
+        }
+        for (size_t i = 0; i < parcial.histogramaGrado.size(); ++i) {
+            destino.histogramaGrado[i] += parcial.histogramaGrado[i];
+        }
+    };
+    if (compartido) {
+        // En un DAG cada nodo físico se cuenta una vez, aunque cuelgue de varios padres
+        EstadisticasMemoria estadisticas;
+        std::unordered_set<const NodoArbol*> vistos;
+        std::vector<const NodoArbol*> pendientes;
+        if (raiz) pendientes.push_back(raiz);
+        while (!pendientes.empty()) {
+            const NodoArbol* nodo = pendientes.back();
+            pendientes.pop_back();
+            if (nodo->referencias > 1 && !vistos.insert(nodo).second) continue;
+            acumularMemoria(nodo, estadisticas);
+            pendientes.insert(pendientes.end(), nodo->hijos.begin(), nodo->hijos.end());
+        }
+        return estadisticas;
+    }
+    return visitarParalelo(raiz, EstadisticasMemoria(),
+        [](EstadisticasMemoria& estadisticas, const NodoArbol& nodo, const ContextoVisita&) {
+            acumularMemoria(&nodo, estadisticas);
+        },
+        combinar);
+}
+
+// Función auxiliar para acumular la memoria de un nodo (sin sus hijos)
+void ArbolSistemaArchivos::acumularMemoria(const NodoArbol* nodo, EstadisticasMemoria& estadisticas) {
+    estadisticas.nodos++;
+    estadisticas.bytesNodos += static_cast<long long>(sizeof(NodoArbol));
+    estadisticas.bytesSobrecarga += bloqueAsignador(sizeof(NodoArbol)) - static_cast<long long>(sizeof(NodoArbol));
+
+    // Un std::string vacío tiene capacity() igual al buffer SSO: por encima de eso vive en el heap
+    if (nodo->nombre.capacity() > std::string().capacity()) {
+        size_t reservado = nodo->nombre.capacity() + 1;
+        estadisticas.bytesNombres += static_cast<long long>(nodo->nombre.size() + 1);
+        estadisticas.bytesHolgura += static_cast<long long>(nodo->nombre.capacity() - nodo->nombre.size());
+        estadisticas.bytesSobrecarga += bloqueAsignador(reservado) - static_cast<long long>(reservado);
+    }
+
+    if (nodo->hijos.capacity() > 0) {
+        size_t reservado = nodo->hijos.capacity() * sizeof(NodoArbol*);
+        estadisticas.bytesHijos += static_cast<long long>(nodo->hijos.size() * sizeof(NodoArbol*));
+        estadisticas.bytesHolgura += static_cast<long long>((nodo->hijos.capacity() - nodo->hijos.size()) * sizeof(NodoArbol*));
+        estadisticas.bytesSobrecarga += bloqueAsignador(reservado) - static_cast<long long>(reservado);
+    }
+
+    // El índice Eytzinger de los directorios grandes cuenta como parte de los arreglos de hijos
+    if (nodo->indice) {
+        estadisticas.bytesHijos += nodo->indice->bytesMemoria();
+    }
+
+    if (!nodo->hijos.empty()) {
+        size_t cubeta = static_cast<size_t>(std::bit_width(nodo->hijos.size())) - 1;
+        if (estadisticas.histogramaGrado.size() <= cubeta) {
+            estadisticas.histogramaGrado.resize(cubeta + 1, 0);
+        }
+        estadisticas.histogramaGrado[cubeta]++;
+    }
+}
+
+// Función para recortar en el lugar la capacidad sobrante; retorna los bytes liberados
+long long ArbolSistemaArchivos::reducirMemoria() {
+    if (!raiz) return 0;
+
+    long long antes = estadisticasMemoria().total();
+    reducirMemoria(raiz);
+    return antes - estadisticasMemoria().total();
+}
+
+// Función auxiliar recursiva para recortar la holgura de un subárbol
+void ArbolSistemaArchivos::reducirMemoria(NodoArbol* nodo) {
+    nodo->hijos.shrink_to_fit();
+    nodo->nombre.shrink_to_fit();
+
+    for (NodoArbol* hijo : nodo->hijos) {
+        reducirMemoria(hijo);
+    }
+}
+
+// Función para copiar en profundidad un subárbol (incluye metadatos y hashes en caché)
+NodoArbol* ArbolSistemaArchivos::clonarSubarbol(const NodoArbol* nodo) {
+    NodoArbol* copia = new NodoArbol(nodo->nombre);
+    copia->tamano = nodo->tamano;
+    copia->tipo = nodo->tipo;
+    copia->hashSubarbol = nodo->hashSubarbol;
+    copia->hijos.reserve(nodo->hijos.size());
+    for (const NodoArbol* hijo : nodo->hijos) {
+        copia->hijos.push_back(clonarSubarbol(hijo));
+    }
+    return copia;
+}
+
+// Función para calcular el hash de una ruta tal como la entiende dividirRuta (separadores repetidos,
+// iniciales o finales no cuentan), sin construir los componentes
+std::uint64_t ArbolSistemaArchivos::hashRuta(const std::string& ruta) {
+    return finalizarHashRuta(estadoHashRuta(ruta));
+}
+
+// Estado FNV-1a sin la mezcla final, para poder extenderlo con los hijos
+std::uint64_t ArbolSistemaArchivos::estadoHashRuta(const std::string& ruta) {
+    return extenderEstadoRuta(FNV_BASE, ruta);
+}
+
+// Función para obtener el hash de filtro a partir del estado FNV de una ruta
+std::uint64_t ArbolSistemaArchivos::finalizarEstadoRuta(std::uint64_t estado) {
+    return finalizarHashRuta(estado);
+}
+
+// Función para continuar el estado FNV de un directorio con una ruta relativa a él
+std::uint64_t ArbolSistemaArchivos::extenderEstadoRuta(std::uint64_t estado, const std::string& rutaRelativa) {
+    bool enComponente = false;
+    for (char c : rutaRelativa) {
+        if (c == '/' || c == '\\') {
+            enComponente = false;
+            continue;
+        }
+        if (!enComponente) {
+            estado = (estado ^ static_cast<unsigned char>('/')) * FNV_PRIMO;
+            enComponente = true;
+        }
+        estado = (estado ^ static_cast<unsigned char>(c)) * FNV_PRIMO;
+    }
+    return estado;
+}
+
+// Función para agregar (o quitar) del filtro las rutas de un subárbol ya enganchado al árbol.
+// Retorna false si el filtro se llenó y se reconstruyó (la reconstrucción ya cubre el subárbol)
+bool ArbolSistemaArchivos::registrarSubarbolEnFiltro(const NodoArbol* nodo, std::uint64_t estado, bool agregar) {
+    if (!agregar) {
+        filtro->eliminar(finalizarHashRuta(estado));
+    } else if (!filtro->insertar(finalizarHashRuta(estado))) {
+        reconstruirFiltro();
+        return false;
+    }
+
+    for (const NodoArbol* hijo : nodo->hijos) {
+        if (!registrarSubarbolEnFiltro(hijo, extenderHashRuta(estado, hijo->nombre), agregar)) return false;
+    }
+    return true;
+}
+
+// Función para rehacer el filtro desde el árbol con holgura para crecer (duplica si no alcanza)
+void ArbolSistemaArchivos::reconstruirFiltro() {
+    long long capacidad = std::max(1024LL, static_cast<long long>(obtenerNumeroNodos()) * 3 / 2);
+    while (true) {
+        delete filtro;
+        filtro = new FiltroCuckoo(capacidad);
+
+        // La raíz ("" o "/") va siempre: buscar solo retorna antes por !raiz, y buscarEn también
+        // consulta el filtro con el directorio del manejador y una ruta relativa vacía
+        bool completo = filtro->insertar(finalizarHashRuta(FNV_BASE));
+        if (raiz && completo) {
+            for (const NodoArbol* hijo : raiz->hijos) {
+                // Sin llamar a registrarSubarbolEnFiltro: aquí un fallo no debe reconstruir de nuevo
+                std::vector<std::pair<const NodoArbol*, std::uint64_t>> pila = {{hijo, extenderHashRuta(FNV_BASE, hijo->nombre)}};
+                while (!pila.empty() && completo) {
+                    auto [nodo, estado] = pila.back();
+                    pila.pop_back();
+                    completo = filtro->insertar(finalizarHashRuta(estado));
+                    for (const NodoArbol* nieto : nodo->hijos) {
+                        pila.push_back({nieto, extenderHashRuta(estado, nieto->nombre)});
+                    }
+                }
+                if (!completo) break;
+            }
+        }
+        if (completo) return;
+        capacidad *= 2;
+    }
+}
+
+// Función para activar el filtro negativo de buscar (se construye con el contenido actual)
+void ArbolSistemaArchivos::activarFiltroNegativo() {
+    reconstruirFiltro();
+}
+
+void ArbolSistemaArchivos::desactivarFiltroNegativo() {
+    delete filtro;
+    filtro = nullptr;
+}
+
+// Función para consultar el filtro activo (nullptr si no hay). El puntero deja de ser válido con
+// cualquier mutación del árbol: si el filtro se llena, insertar lo reconstruye en otro objeto
+const FiltroCuckoo* ArbolSistemaArchivos::obtenerFiltroNegativo() const {
+    return filtro;
+}
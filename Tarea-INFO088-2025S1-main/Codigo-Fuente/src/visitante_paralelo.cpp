@@ -0,0 +1,72 @@
+#include "visitante_paralelo.h"
+
+// Constructor del equipo (los hilos se crean en lanzar, según se necesiten)
+EquipoHilos::EquipoHilos() : activos(0), enCurso(0), ronda(0), cerrando(false), ocupado(false) {}
+
+// Destructor del equipo: despierta a los ayudantes para que terminen y los espera
+EquipoHilos::~EquipoHilos() {
+    {
+        std::lock_guard<std::mutex> guardia(cerrojo);
+        cerrando = true;
+    }
+    hayTrabajo.notify_all();
+    for (std::thread& hilo : hilos) {
+        hilo.join();
+    }
+}
+
+// Función para obtener el equipo compartido por todos los recorridos
+EquipoHilos& EquipoHilos::global() {
+    static EquipoHilos equipo;
+    return equipo;
+}
+
+// Función para repartir 'funcion' entre 'ayudantes' hilos (reciben los índices 1..ayudantes).
+// Retorna false sin lanzar nada si otro recorrido está usando el equipo. 'ocupado' es un indicador
+// atómico y no un mutex: una llamada anidada desde el hilo que ya lo tomó haría try_lock sobre un
+// mutex propio (comportamiento indefinido), mientras que aquí simplemente lo encuentra tomado
+bool EquipoHilos::lanzar(unsigned ayudantes, std::function<void(unsigned)> funcion) {
+    if (ayudantes == 0 || ocupado.exchange(true, std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> guardia(cerrojo);
+    while (hilos.size() < ayudantes) {
+        unsigned indice = static_cast<unsigned>(hilos.size());
+        hilos.emplace_back(&EquipoHilos::bucleAyudante, this, indice);
+    }
+    trabajo = std::move(funcion);
+    activos = ayudantes;
+    enCurso = ayudantes;
+    ronda++;
+    hayTrabajo.notify_all();
+    return true;
+}
+
+// Función para esperar a que los ayudantes terminen el trabajo lanzado y liberar el equipo
+void EquipoHilos::esperar() {
+    {
+        std::unique_lock<std::mutex> guardia(cerrojo);
+        terminado.wait(guardia, [this] { return enCurso == 0; });
+        trabajo = nullptr;
+    }
+    ocupado.store(false, std::memory_order_release);
+}
+
+// Función que corre cada ayudante: duerme hasta una nueva ronda en la que participe
+void EquipoHilos::bucleAyudante(unsigned indice) {
+    unsigned long long vista = 0;
+    std::unique_lock<std::mutex> guardia(cerrojo);
+    while (true) {
+        hayTrabajo.wait(guardia, [&] { return cerrando || (ronda != vista && indice < activos); });
+        if (cerrando) return;
+        vista = ronda;
+
+        std::function<void(unsigned)>& funcion = trabajo;
+        guardia.unlock();
+        funcion(indice + 1);
+        guardia.lock();
+
+        if (--enCurso == 0) {
+            terminado.notify_one();
+        }
+    }
+}